@@ -0,0 +1,53 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File array.h
+
+An array is a contiguous sequence of pointers that grows as elements are appended. It is used 
+instead of a list where elements are only appended and the sequence is traversed or indexed, 
+e.g., for the cubes of each degree of an HDA, the queue of states, and the variables. This file 
+defines arrays and declares functions for them.
+************************************************************************************************/
+
+#ifndef ARRAY_H
+#define ARRAY_H
+
+struct list;
+
+typedef struct array array;
+
+struct array {
+	unsigned int n, size;	/*number of elements, number of allocated slots*/
+	void **el;	/*elements*/
+};
+
+void InitArray(array *a); /*Initializes a as an empty array*/
+void ClearArray(array *a, void (*del)(void *)); /*Frees the memory of the elements of a, deletes the elements using the del function unless it is NULL, and makes a empty*/
+array *NewArray(void); /*Creates new empty array*/
+void DeleteArray(array *a, void (*del)(void *)); /*Deletes array, deletes elements using the del function unless it is NULL*/
+void AppendToArray(array *a, void *p); /*Appends p to the array*/
+void SortArray(array *a, int (*cmp)(const void *, const void *)); /*Sorts the elements by cmp, which is given pointers to two elements as in qsort*/
+array *ListToArray(const struct list *l); /*Creates an array with the elements of the list in the same order*/
+
+#endif
@@ -0,0 +1,59 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File bytecode.h
+
+Bytecode is a compiled form of an expression for a stack machine. Variables are resolved to their 
+positions in the valuation vectors of the states, constant subexpressions are folded at compile 
+time, and the boolean operators && and || are compiled to short-circuit jumps. The code of a 
+subexpression shared in an expression DAG (see exprdag.h) is enclosed by instructions that take 
+its value from the cache of the DAG if it has been computed for the current valuation and store 
+it there otherwise. This file defines bytecode and declares functions for compiling and running it.
+************************************************************************************************/
+
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+struct ast;
+struct array;
+struct exprdag;
+
+typedef struct instruction instruction;
+typedef struct bytecode bytecode;
+
+struct instruction {
+	int op;	/*operation*/
+	int arg;	/*constant, variable position or jump target, depending on op*/
+};
+struct bytecode {
+	int n;	/*number of instructions*/
+	int depth;	/*maximal stack depth*/
+	instruction *in;	/*instructions*/
+};
+
+bytecode *CompileAst(const struct ast *exp, const struct array *vars, const struct exprdag *dag); /*Compiles the expression over the variables in vars, caching the values of the subexpressions shared in dag unless it is NULL, returns NULL if the expression is NULL or contains a variable not in vars*/
+void DeleteBytecode(void *code); /*Deletes given bytecode*/
+int RunBytecode(const bytecode *code, const int *vals, struct exprdag *dag); /*Evaluates the compiled expression for the values vals of the variables, the values cached in dag (if not NULL) must belong to vals*/
+
+#endif
@@ -0,0 +1,42 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File codegen.h
+
+With the option --codegen, the guards and effects of the transitions are translated into C 
+functions on the valuation vectors of the states, which are compiled by the system C compiler 
+into a shared object and loaded at run time. This file declares the functions generating, 
+loading and unloading this native code.
+************************************************************************************************/
+
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+struct vector;
+struct array;
+
+void *LoadNativeCode(const struct vector *pgvec, const struct array *vars); /*Generates and compiles native code for the transitions of the program graphs in pgvec over the variables in vars and sets the native functions of the transitions, returns the handle of the loaded shared object or NULL if the code could not be compiled or loaded*/
+void UnloadNativeCode(void *handle, const struct vector *pgvec); /*Resets the native functions of the transitions of the program graphs in pgvec and unloads the shared object*/
+
+#endif
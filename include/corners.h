@@ -0,0 +1,51 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File corners.h
+
+A corner table contains the vertices of all cubes of an HDA up to a given degree. It is computed 
+degree by degree in one pass over the cube arrays and stores the vertices of the cubes of each 
+degree in one array indexed by the numbers of the cubes. This file defines corner tables and 
+declares functions for them.
+************************************************************************************************/
+
+#ifndef CORNERS_H
+#define CORNERS_H
+
+struct array;
+struct cube;
+
+typedef struct cornertable cornertable;
+
+struct cornertable {
+	unsigned int dim;	/*maximal degree of the cubes in the table*/
+	unsigned int *count;	/*count[d] is the number of cubes of degree d*/
+	struct cube ***vert;	/*vert[d] contains the 2^d vertices of each cube of degree d, those of the cube with number i start at position i * 2^d*/
+};
+
+cornertable *NewCornertable(struct array *const cubelist[], unsigned int dim); /*Computes the vertices of all cubes of degree at most dim of HDA cubelist*/
+void DeleteCornertable(cornertable *ct); /*Deletes the given corner table (but not the cubes)*/
+struct cube *const *CubeVertices(const cornertable *ct, const struct cube *pc); /*Returns the 2^k vertices of the cube pc of degree k <= ct->dim without allocating memory, the initial and the final vertex come first*/
+
+#endif
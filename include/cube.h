@@ -31,7 +31,9 @@ This file declares cubes and functions for cubes.
 #define CUBE_H
 
 struct vector;
-struct list;
+struct array;
+struct cubeset;
+struct cubeindex;
 
 typedef struct label label;
 typedef struct flagfield flagfield;
@@ -47,12 +49,12 @@ struct flagfield {
 };
 struct cube {
 	unsigned int degree; 
+	unsigned int id;	/*number of the cube among the cubes of the same degree (in the order of insertion)*/
 	flagfield flags;
 	cube **d[2];	/*boundary operators*/
-	struct list **s[2];	/*cofaces*/	
+	struct cubeset *s[2];	/*cofaces: s[k][i] contains the cubes c with c->d[k][i] == this cube*/	
 	struct vector *edges; /*the edges starting at the origin of the cube, which correspond to the actions whose independence is represented by the cube*/
 	struct vector *lab; /*label*/ 
-	struct list *cl;	/*pointer to cube list position*/	
 	void *furtherdata; /*further data, e.g. a pointer to a cube used for reduction*/		
 };
 
@@ -64,8 +66,9 @@ int *NewInt(int n); /*Creates new int with value n*/
 void DeleteInt(void *n); /*Deletes given int*/
 cube *NewCube(unsigned int d); /*Creates new cube of degree d*/
 void DeleteCube(void *pc); /*Deletes the given cube*/
-struct vector *Vertices(cube *pc); /*Computes the vertices of a cube, the initial and the final vertex come first*/
-struct vector *Edges(cube *pc); /*Computes the edges of pc starting in the initial vertex of pc*/
-int FillCubes(cube *edge, struct list *cubelist[]);	/*Completes HDA cubelist at given edge, returns the dimension of the highest cube added, returns -1 if no cube is added*/ 
+void InsertCube(cube *pc, struct array *cubelist[]); /*Appends pc to the array of cubes of its degree in cubelist and numbers it accordingly*/
+int BdIdsOK(const cube *pc); /*Returns 1 if cube satisfies the boundary identities and 0 else*/
+int BdIdsOKExcept(const cube *pc, int e); /*Returns 1 if cube satisfies the boundary identities between its faces d[k][i] and d[l][j] with i, j != e and 0 else*/
+int FillCubes(cube *edge, struct array *cubelist[], struct cubeindex *index);	/*Completes HDA cubelist at given edge and adds the new cubes to index, returns the dimension of the highest cube added, returns -1 if no cube is added*/ 
 
 #endif
@@ -0,0 +1,53 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File cubeindex.h
+
+A cube index is a hash index that locates the cubes of an HDA by their boundaries: for every 
+degree d >= 1, the cubes of degree d are the keys of a hash map (see hashmap.h) that hashes them by 
+their boundary signature (the numbers of the faces d[0][0],..., d[0][d-1], d[1][0],..., d[1][d-1]) 
+and compares their faces. The faces of a cube must therefore be numbered (see InsertCube()) before 
+the cube is indexed or looked up. This file defines cube indexes and declares functions for them.
+************************************************************************************************/
+
+#ifndef CUBEINDEX_H
+#define CUBEINDEX_H
+
+struct cube;
+struct hashmap;
+
+typedef struct cubeindex cubeindex;
+
+struct cubeindex {
+	unsigned int dim;	/*maximal degree of the indexed cubes*/
+	struct hashmap **t;	/*t[d - 1] contains the cubes of degree d*/
+};
+
+cubeindex *NewCubeindex(unsigned int dim); /*Creates new empty index for cubes of degree 1,..., dim*/
+void DeleteCubeindex(cubeindex *ci); /*Deletes the given index (but not the cubes)*/
+void AddToCubeindex(cubeindex *ci, struct cube *pc); /*Inserts pc (whose boundary must be complete) in the index*/
+struct cube *FindCube(const cubeindex *ci, unsigned int d, struct cube *const bd0[], struct cube *const bd1[]); /*Returns a cube of degree d with boundaries d[0][i] == bd0[i] and d[1][i] == bd1[i] if there is one and NULL otherwise*/
+struct cube *LookupCube(const cubeindex *ci, const struct cube *pc); /*Returns an indexed cube with the same boundary as pc if there is one and NULL otherwise*/
+
+#endif
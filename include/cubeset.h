@@ -0,0 +1,68 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File cubeset.h
+
+A cube set is a set of cubes of the same degree, stored as an array sorted by the numbers of the 
+cubes. Cube sets are used for the cofaces of cubes. This file defines cube sets and declares 
+functions for them, in particular intersection functions that do not allocate memory.
+************************************************************************************************/
+
+#ifndef CUBESET_H
+#define CUBESET_H
+
+#define CUBESET_INLINE 2	/*number of elements that are stored in the cube set itself*/
+
+#define CubesetIds(s) ((s)->cap > CUBESET_INLINE ? (s)->heap.id : (s)->inl.id)	/*array of the numbers of the elements of s*/
+#define CubesetCubes(s) ((s)->cap > CUBESET_INLINE ? (s)->heap.el : (s)->inl.el)	/*array of the elements of s*/
+
+struct cube;
+
+typedef struct cubeset cubeset;
+
+struct cubeset {
+	unsigned int n, cap;	/*number of elements, capacity*/
+	union {
+		struct {
+			unsigned int *id;	/*numbers of the elements in increasing order*/
+			struct cube **el;	/*elements, el[i] is the cube with number id[i]*/
+		} heap;	/*used if cap > CUBESET_INLINE*/
+		struct {
+			unsigned int id[CUBESET_INLINE];
+			struct cube *el[CUBESET_INLINE];
+		} inl;	/*used if cap == CUBESET_INLINE*/
+	};
+};
+
+void InitCubeset(cubeset *s); /*Initializes s as an empty cube set*/
+void ClearCubeset(cubeset *s); /*Removes all elements from s and frees its memory*/
+void EmptyCubeset(cubeset *s); /*Removes all elements from s but keeps its memory*/
+void ReserveCubeset(cubeset *s, unsigned int cap); /*Makes sure that s can hold cap elements*/
+void AddToCubeset(cubeset *s, struct cube *pc); /*Inserts pc in s (if it is not yet an element)*/
+int IsInCubeset(const struct cube *pc, const cubeset *s); /*Returns 1 if pc belongs to s and 0 otherwise*/
+void CopyCubeset(cubeset *dst, const cubeset *src); /*Makes dst a copy of src*/
+unsigned int IntersectCubesets(cubeset *dst, const cubeset *s1, const cubeset *s2); /*Computes the intersection of s1 and s2 in dst, returns the number of its elements*/
+unsigned int RestrictCubeset(cubeset *s, const cubeset *t); /*Replaces s by its intersection with t (without allocating memory), returns the number of remaining elements*/
+
+#endif
@@ -0,0 +1,68 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File cubestore.h
+
+A cube store is a compact representation of a completed HDA. The cubes of each degree are 
+identified by their numbers (see cube->id), and all cross-references are 32-bit numbers kept in 
+contiguous arrays per degree: the boundaries and the edges of the cubes, and, in compressed 
+sparse row format, their cofaces. The store takes over the labels of the vertices and edges, so 
+that the cubes can be deleted once it has been built. This file defines cube stores and declares 
+functions for them.
+************************************************************************************************/
+
+#ifndef CUBESTORE_H
+#define CUBESTORE_H
+
+#include <stdint.h>
+
+struct vector;
+struct array;
+struct flagfield;
+
+typedef struct storelevel storelevel;
+typedef struct cubestore cubestore;
+
+struct storelevel {
+	uint32_t n;	/*number of cubes of this degree d*/
+	uint32_t *bd[2];	/*bd[k][i * d + j] is the number of the face d^k_{j+1} of cube i*/
+	uint32_t *edges;	/*edges[i * d + j] is the number of the j-th edge of cube i (see cube->edges)*/
+	uint32_t *cooff[2];	/*the cofaces c of cube i with i in the k-boundary of c are coid[k][cooff[k][i]],..., coid[k][cooff[k][i + 1] - 1]*/
+	uint32_t *coid[2];	/*numbers of the cofaces of degree d + 1 in increasing order for each cube*/
+	struct vector **lab;	/*lab[i] is the label of cube i (only for degree 0 and 1)*/
+	struct flagfield *flags;	/*flags[i] are the flags of cube i (only for degree 0)*/
+};
+struct cubestore {
+	int dim;	/*dimension of the HDA*/
+	storelevel *lev;	/*lev[d] contains the cubes of degree d*/
+};
+
+cubestore *NewCubestore(int dim); /*Creates new empty store for an HDA of dimension dim*/
+void DeleteCubestore(cubestore *cs); /*Deletes the given store and the labels it contains*/
+void StoreDegree(cubestore *cs, const struct array *cubelist, int d); /*Stores the cubes of degree d in cubelist and builds the coface arrays of degree d - 1, takes over the labels of the cubes, the degrees have to be stored in increasing order*/
+cubestore *StoreHDA(struct array *const cubes[], int dim); /*Creates the store of HDA cubes of dimension dim*/
+void ReduceCubestore(cubestore *cs); /*Contracts the maximal chains of edges through vertices which are neither initial nor final and have exactly one incoming and one outgoing edge and no incident squares into single edges labelled by the concatenated label words*/
+void ReorderCubestore(cubestore *cs); /*Renumbers the cubes for locality: the vertices in breadth-first order of the 1-skeleton starting at the initial vertex, the cubes of degree d >= 1 by the new numbers of their faces*/
+
+#endif
@@ -37,6 +37,13 @@ This file declares global variables and defines macros used in various modules.
 #define OPTION_i 2
 #define OPTION_c 3
 #define OPTION_t 4
+#define OPTION_batch 1
+#define OPTION_reorder 1
+#define OPTION_reduce 1
+#define OPTION_verify 1
+#define OPTION_codegen 1
+#define OPTION_minimize 1
+#define OPTION_symbolic 1
 
 /*Maximal string length*/
 
@@ -49,6 +56,6 @@ This file declares global variables and defines macros used in various modules.
 	
 /*Global variables for command-line options, initialized in main.c*/
 
-extern unsigned int out, inp;
+extern unsigned int out, inp, build, threads, maxdim, order, reduce, verify, codegen, minimize, symbolic;
 
 #endif	
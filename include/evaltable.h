@@ -0,0 +1,71 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File evaltable.h
+
+An evaluation table stores the evaluations of the variables listed for a condition or an action 
+in the input format of the first versions (--old) in a form that can be looked up in constant 
+time. An evaluation is encoded by the mixed-radix number whose digits are the offsets of the 
+values from the least values of the domains of the variables. If the number of codes is small 
+compared to the number of evaluations, the table is direct-indexed by the code: a bitmap for a 
+condition and an array of evaluation numbers for an action. Otherwise, it is a sorted array of 
+codes searched by bisection. This file defines evaluation tables and declares functions for 
+them.
+************************************************************************************************/
+
+#ifndef EVALTABLE_H
+#define EVALTABLE_H
+
+#include <stdint.h>
+
+#define EVALTABLE_MAXDIRECT 4096	/*number of codes up to which a table is always direct-indexed*/
+
+struct list;
+struct array;
+struct condition;
+struct action;
+
+typedef struct evaltable evaltable;
+
+struct evaltable {
+	int n;	/*number of variables*/
+	int *slot;	/*slot[i] is the position of variable i in the valuations*/
+	int *min;	/*min[i] is the least value of the domain of variable i*/
+	uint64_t *radix, *stride;	/*radix[i] is the number of codes for variable i, stride[i] the weight of its digit*/
+	uint64_t size;	/*number of codes*/
+	uint64_t *bits;	/*direct-indexed table of a condition: bit c is set if code c is an evaluation, NULL otherwise*/
+	int *row;	/*direct-indexed table of an action: row[c] is the number of the evaluation with code c or -1, NULL otherwise*/
+	uint64_t *code;	/*sorted codes of the evaluations if the table is not direct-indexed, NULL otherwise*/
+	int *coderow;	/*coderow[i] is the number of the evaluation with code code[i] for an action, NULL otherwise*/
+	int no_codes;	/*number of sorted codes*/	
+};
+
+evaltable *TabulateCondition(const struct condition *cond, const struct array *vars); /*Creates the table of the evaluations of the condition, returns NULL if a variable of the condition is not in vars or has an empty domain*/
+evaltable *TabulateAction(const struct action *act, const struct array *vars); /*Creates the table of the evaluations for which the effect of the action is defined, returns NULL if a variable of the action is not in vars or has an empty domain*/
+void DeleteEvaltable(void *tab); /*Deletes given table*/
+int ContainsEvaluation(const evaltable *tab, const int *vals); /*Returns 1 if the values of the variables of the table in the valuation vals form one of its evaluations and 0 otherwise*/
+int FindEvaluation(const evaltable *tab, const int *vals); /*Returns the number of the first evaluation of the action whose arguments are the values of the variables of the table in the valuation vals, -1 if there is none*/
+
+#endif
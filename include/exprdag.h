@@ -0,0 +1,67 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File exprdag.h
+
+An expression DAG contains the expressions of all program graphs of the system, hash-consed so 
+that equal subexpressions (up to parentheses) are represented by a single node. A node referenced 
+more than once is shared. The bytecode of the expressions (see bytecode.h) caches the values of 
+the shared nodes in the DAG between the evaluations for one valuation of the variables, so that 
+a subexpression shared by several guards or assignments is evaluated at most once per state. 
+This file defines expression DAGs and declares functions for them.
+************************************************************************************************/
+
+#ifndef EXPRDAG_H
+#define EXPRDAG_H
+
+#define DAG_NUM 0	/*kinds of nodes besides the ast operators*/
+#define DAG_VAR -1
+
+struct ast;
+struct array;
+struct hashmap;
+
+typedef struct dagnode dagnode;
+typedef struct exprdag exprdag;
+
+struct dagnode {
+	int op;	/*DAG_NUM, DAG_VAR or an ast operator*/
+	int a, b;	/*number or variable position (DAG_NUM, DAG_VAR), indices of the operands otherwise (-1 if absent)*/
+	int refs;	/*number of references from other nodes and from the expressions added to the DAG*/
+};
+struct exprdag {
+	int n, size;	/*number of nodes, number of allocated nodes*/
+	dagnode *node;	/*nodes, the operands of a node precede it*/
+	struct hashmap *index;	/*maps the INT vectors (op, a, b) to the node indices plus 1*/
+	unsigned int stamp, *mark;	/*the value of node i is cached if mark[i] == stamp*/
+	int *val;	/*cached values*/
+};
+
+exprdag *NewExprdag(); /*Creates new empty expression DAG*/
+void DeleteExprdag(exprdag *dag); /*Deletes given expression DAG*/
+int AddToExprdag(exprdag *dag, const struct ast *exp, const struct array *vars); /*Adds the expression over the variables in vars to the DAG, returns the index of its node or -1 if the expression is NULL or contains a variable not in vars*/
+int FindInExprdag(const exprdag *dag, const struct ast *exp, const struct array *vars); /*Returns the index of the node of the expression over the variables in vars, -1 if it is not in the DAG*/
+void ForgetValues(exprdag *dag); /*Discards the cached values, must be called when the values of the variables change*/
+
+#endif
@@ -0,0 +1,55 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File hashmap.h
+
+A hash map associates values with keys, which are either pointers compared by identity (type PTR) 
+or INT vectors compared by their coordinates (type INT), or keys of any other kind hashed and 
+compared by functions given when the map is created. A hash map whose values are all NULL is used 
+as a set. This file defines hash maps and declares functions for them.
+************************************************************************************************/
+
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+typedef struct hashmap hashmap;
+
+struct hashmap {
+	int type;	/*type of the keys, PTR or INT*/
+	unsigned int size, n;	/*number of slots (a power of 2), number of keys*/
+	void **key;	/*keys (NULL for an empty slot)*/
+	void **val;	/*values of the keys*/
+	unsigned int *hash;	/*hash values of the keys*/
+	unsigned int (*hashfn)(const void *key);	/*hash function of the keys, NULL for the keys of type PTR or INT*/
+	int (*samefn)(const void *key1, const void *key2);	/*returns 1 if the keys are equal and 0 otherwise, NULL for the keys of type PTR or INT*/
+};
+
+hashmap *NewHashmap(int type); /*Creates new empty hash map for keys of the given type*/
+hashmap *NewCustomHashmap(unsigned int (*hashfn)(const void *key), int (*samefn)(const void *key1, const void *key2)); /*Creates new empty hash map for keys hashed by hashfn and compared by samefn*/
+void DeleteHashmap(hashmap *hm, void (*delkey)(void *)); /*Deletes the given hash map and, unless delkey is NULL, its keys by means of delkey (but not the values)*/
+int AddToHashmap(hashmap *hm, void *key, void *val); /*Inserts the key (which must not be NULL) with value val and returns 1 if hm does not yet contain the key, returns 0 and leaves hm unchanged otherwise*/
+void *LookupKey(const hashmap *hm, const void *key); /*Returns the value of the key in hm, NULL if hm does not contain the key*/
+int IsKey(const hashmap *hm, const void *key); /*Returns 1 if hm contains the key and 0 otherwise*/
+
+#endif
@@ -32,10 +32,12 @@ the computation of HDAs from program graphs.
 #define HDA_H
 
 struct vector;
-struct list;
+struct array;
 struct location;
 struct programgraph;
 struct cube;
+struct cubeindex;
+struct exprdag;
 
 typedef struct state state;
 
@@ -47,6 +49,7 @@ struct state {
 
 state *NewState(int pgs, int vars); /*Creates new state for pgs program graphs and vars variables*/
 void DeleteState(void *st); /*Deletes state (but not its cube)*/
-int MakeHDA(const struct vector *pgvec, struct list *cubelist[], const struct list *varlist); /*Transforms system of program graphs (pgvec) over the variables in varlist into HDA cubelist, returns the dimension of the HDA*/
+struct array *InitialStates(const struct vector *pgvec, const struct array *vars); /*Computes the initial global states of the system of program graphs in pgvec*/
+int MakeHDA(const struct vector *pgvec, struct array *cubelist[], struct cubeindex *index, const struct array *vars, struct exprdag *dag); /*Transforms system of program graphs (pgvec) over the variables in vars into HDA cubelist, whose cubes are added to index, guards and assignments entered in dag (if not NULL) are evaluated once per state, returns the dimension of the HDA*/
 
 #endif
@@ -0,0 +1,140 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File hdcubes.h
+
+This file is a template for the kernel that completes an HDA by introducing cubes of a given 
+degree >= 3 at a 1-cube. It is included by cube.c, which defines HD_KERNEL as the name of the 
+function to instantiate and HD_DEGREE as its degree. If HD_DEGREE is a constant, all arrays of 
+the kernel have fixed size and the loops over the faces of a cube can be unrolled by the compiler; 
+if it is the parameter degree, the kernel is the generic one.
+************************************************************************************************/
+
+#if !defined(HD_KERNEL) || !defined(HD_DEGREE)
+#error "hdcubes.h requires HD_KERNEL and HD_DEGREE"
+#endif
+
+static int HD_KERNEL(cube *const edge, array *cubelist[], cubeindex *index, int degree, int facecount) {
+
+	int  newcount = 0, nconfig, c, i, j, edgeindex, *config, *vc, pos, more, up, tx[2], idx[HD_DEGREE - 1], oppn[HD_DEGREE - 1], upperindex[HD_DEGREE - 1];
+	unsigned int compat[HD_DEGREE - 1];
+	const int edgepid = ((label **) edge->lab->coord)[0]->num;
+	vector *facevec = NewVector(facecount, sizeof(cube *));	
+	cube **faces = facevec->coord, *top[2], *cub, *bd[2][HD_DEGREE], cand;
+	const array *faceset = cubelist[HD_DEGREE - 1];
+	cubeset topset[2], oppset[HD_DEGREE - 1];
+	candidate cd = {&cand, 0, upperindex, oppset};
+	productiter it;
+
+	InitCubeset(&topset[0]);
+	InitCubeset(&topset[1]);
+	for (j = 0; j < HD_DEGREE - 1; j++)
+		InitCubeset(&oppset[j]);
+/*the candidates are assembled in cand, whose boundary lives on the stack*/
+	cand.degree = HD_DEGREE;
+	cand.d[0] = bd[0];
+	cand.d[1] = bd[1];
+/*determine faces containing edge and their configurations with compatible pids*/
+	for (i = 0; i < facecount; i++) 
+		faces[i] = faceset->el[faceset->n - 1 - i];
+	config = Config(edge, HD_DEGREE, facecount, faces, &nconfig);
+/*for each configuration of faces with compatible pids*/
+	for (c = 0; c < nconfig; c++) {
+		vc = &config[c * (HD_DEGREE - 1)];
+/*determine edgeindex*/
+		for (i = 0; i < HD_DEGREE - 1; i++) {
+			if (((label **) ((cube **) faces[vc[0]]->edges->coord)[i]->lab->coord)[0]->num == edgepid) {	
+				edgeindex = i;
+				break;
+			}
+		}	
+		if (edgeindex > 0 || ((label **) ((cube **) faces[vc[1]]->edges->coord)[0]->lab->coord)[0]->num != edgepid) 
+			edgeindex += 1;	
+		cd.edgeindex = edgeindex;
+/*for each vector of compatible upper indexes*/				
+		for (up = FirstUpperindex(edgeindex, faces, vc, HD_DEGREE, compat, upperindex); up; up = NextUpperindex(HD_DEGREE, compat, upperindex)) {
+/*determine all possible top and bottom faces (wrt edge)*/ 
+			for (i = 0; i < 2; i++) {
+				CopyCubeset(&topset[i], &faces[vc[0]]->d[i][edgeindex > 0 ? edgeindex - 1 : 0]->s[upperindex[0]][0]);
+				for (j = 1; j < HD_DEGREE - 1 && topset[i].n; j++) 
+					RestrictCubeset(&topset[i], &faces[vc[j]]->d[i][j < edgeindex ? edgeindex - 1 : edgeindex]->s[upperindex[j]][j]);
+				if (!topset[i].n) 
+					break;
+			}								
+/*for all possible top and bottom faces*/ 
+			for (tx[0] = 0; tx[0] < topset[0].n && topset[1].n; tx[0]++) {
+				top[0] = CubesetCubes(&topset[0])[tx[0]];
+				for (tx[1] = 0; tx[1] < topset[1].n; tx[1]++) {
+					top[1] = CubesetCubes(&topset[1])[tx[1]];
+/*determine the sets of possible opposite faces of the ones in the current configuration*/
+					more = 1;
+					for (j = 0; j < HD_DEGREE - 1 && more; j++) {
+						pos = j < edgeindex ? edgeindex - 1 : edgeindex;
+						more = IntersectCubesets(&oppset[j], &top[0]->d[1 - upperindex[j]][j]->s[0][pos], &top[1]->d[1 - upperindex[j]][j]->s[1][pos]) > 0;
+						oppn[j] = oppset[j].n;
+					}
+					if (!more)
+						continue;
+/*the candidate consists of the top and bottom faces, the faces of the configuration, and their opposite faces, which are chosen by the product iterator, a vector of opposite faces is not extended once a boundary identity fails*/
+					bd[0][edgeindex] = top[0];			
+					bd[1][edgeindex] = top[1];
+					for (i = 0; i < HD_DEGREE - 1; i++) 
+						bd[upperindex[i]][i < edgeindex ? i : i + 1] = faces[vc[i]];
+					InitProductiter(&it, HD_DEGREE - 1, oppn, idx, OppositeFaceOK, &cd);
+/*for each vector of possible opposite faces of the ones in the current configuration that satisfies the boundary identities (those involving the faces d[0][edgeindex] and d[1][edgeindex] hold by the choice of top and oppset), create a new cube unless there is another cube with the same boundary*/
+					while (NextTuple(&it)) {
+						if (LookupCube(index, &cand))
+							continue;
+						cub = NewCube(HD_DEGREE);
+						memcpy(cub->d[0], bd[0], sizeof(cube *) * HD_DEGREE);
+						memcpy(cub->d[1], bd[1], sizeof(cube *) * HD_DEGREE);
+						InsertCube(cub, cubelist);
+						for (i = 0; i < HD_DEGREE - 1; i++) 
+							((cube **) cub->edges->coord)[i] = ((cube **) cub->d[0][HD_DEGREE - 1]->edges->coord)[i];
+						((cube **) cub->edges->coord)[HD_DEGREE - 1] = ((cube **) cub->d[0][HD_DEGREE - 3]->edges->coord)[HD_DEGREE - 2];
+						AddToCubeset(&top[0]->s[0][edgeindex], cub);
+						AddToCubeset(&top[1]->s[1][edgeindex], cub);
+						for (i = 0; i < HD_DEGREE - 1; i++) {
+							pos = i < edgeindex ? i : i + 1;
+							AddToCubeset(&faces[vc[i]]->s[upperindex[i]][pos], cub);
+							AddToCubeset(&cub->d[1 - upperindex[i]][pos]->s[1 - upperindex[i]][pos], cub);
+						}
+						AddToCubeindex(index, cub);
+						newcount++;
+					}
+				}
+			}
+		}						
+	}
+	free(config);
+	ClearCubeset(&topset[0]);
+	ClearCubeset(&topset[1]);
+	for (j = 0; j < HD_DEGREE - 1; j++)
+		ClearCubeset(&oppset[j]);
+	DeleteVector(facevec);	
+	return newcount;
+}
+
+#undef HD_KERNEL
+#undef HD_DEGREE
@@ -35,10 +35,11 @@ This file declares functions for in and output.
 struct vector;
 struct list;
 struct programgraph;
+struct cubestore;
 
 void ReadPG(FILE *fp, struct list **varlist, struct programgraph *pg, int pid); /*Reads input from file*/
-void PrintSystemHDA(const struct vector* pgvec, const struct list *varlist, struct list *const cubes[], int dim); /*Prints the system and its HDA model*/
-void PrintChainComplex(struct list *const cubes[], int dim); /*Prints chain complex of HDA in Z_2 chomp format*/
-void PrintHDA(struct list *const cubes[], int dim); /*Prints HDA in tsv format*/
+void PrintSystemHDA(const struct vector* pgvec, const struct list *varlist, const struct cubestore *cs, int truncated); /*Prints the system and its HDA model, truncated is 1 if cubes of higher degree have not been computed (--max-dim)*/
+void PrintChainComplex(const struct cubestore *cs, int truncated); /*Prints chain complex of HDA in Z_2 chomp format, truncated is 1 if cubes of higher degree have not been computed*/
+void PrintHDA(const struct cubestore *cs, int truncated); /*Prints HDA in tsv format, truncated is 1 if cubes of higher degree have not been computed*/
 
 #endif
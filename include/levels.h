@@ -0,0 +1,40 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File levels.h
+
+This file declares the function FillLevels, which completes an HDA whose 1-skeleton has been 
+computed by constructing its higher-dimensional cubes level by level, possibly using several 
+threads.
+************************************************************************************************/
+
+#ifndef LEVELS_H
+#define LEVELS_H
+
+struct array;
+struct cubeindex;
+
+int FillLevels(struct array *cubelist[], struct cubeindex *index, int n, int threads); /*Completes HDA cubelist, whose 1-skeleton is complete, level by level by introducing all cubes of degree 2,..., n using the given number of threads, adds the new cubes to index, returns the dimension of the highest cube added, returns -1 if no cube is added*/
+
+#endif
@@ -40,14 +40,13 @@ struct list {
 
 list *InsertElement(void *p, list *l); /*Inserts element with data p in list l, returns head of the list*/
 void Pop(list **l, void (*del)(void *)); /*Pops the head of the list, deletes data using the del function*/
+void RemoveElement(list **l, const void *p); /*Removes the first node with data p from the list without deleting the data, the next node becomes the head if the head is removed*/
 void DeleteList(list **l, void (*del)(void *)); /*Deletes list, deletes data using the del function*/
 int NumberOfElements(const list *l); /*Returns the number of elements in the list*/
 int IsElement(const void *object, const list *l, int (*cmp)(const void *, const void *)); /*Returns 1 if object belongs to list and 0 otherwise*/
 list *Intersection(const list *l1, const list *l2, int (*cmp)(const void *, const void *)); /*Computes the intersection of the two lists (sets), the elements of which are compared by the cmp function*/
 void MergeLists(list **list1, const list *list2, int (*cmp)(const void *, const void *)); /*Merges list2 into list1 by appending the complement at the end, the elements of the lists are compared by the cmp function*/
 void ConcatLists(list **list1, const list *list2); /*Appends list2 to list1*/
-list *Product(const list *list1, const list *list2, int type); /*Produces the cartesian product of two lists of vectors of elements of the given type*/
-list *Transpose(const list *veclist); /*veclist is seen as a matrix with vectors as lines, computes the transposite of this matrix, all vectors must be integer vectors of the same dimension*/
 list *AsVectorList(const list *l); /*Transforms list into list of 1-dimensional vectors*/
 
 #endif
@@ -0,0 +1,76 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File mdd.h
+
+A multi-valued decision diagram (MDD) represents a set of assignments of digits to a fixed 
+sequence of levels. A bounded level l takes the digits 0,..., radix[l] - 1, and a level that is 
+skipped on a path may take any of them. An unbounded level (radix[l] == MDD_UNBOUNDED) takes 
+arbitrary integers, for instance the values of a variable whose range is not known in advance, 
+and is never skipped. A node stores only its children different from the empty set, sorted by 
+digit. The MDD is reduced (no node of a bounded level has the same child for all digits) and 
+hash-consed, so that equal sets are represented by the same node. Node 0 is the empty set and 
+node 1 the set of all assignments. MDDs are used to intersect the initial conditions of the 
+input format of the first versions (--old) and to compute the reachable states symbolically 
+(see symbolic.h). This file defines MDDs and declares functions for them.
+************************************************************************************************/
+
+#ifndef MDD_H
+#define MDD_H
+
+#include <stdint.h>
+
+#define MDD_FALSE 0	/*terminal nodes*/
+#define MDD_TRUE 1
+
+#define MDD_UNBOUNDED -1	/*radix of an unbounded level*/
+
+struct hashmap;
+
+typedef struct mdd mdd;
+
+struct mdd {
+	int levels;	/*number of levels*/
+	int *radix;	/*radix[l] is the number of digits of level l or MDD_UNBOUNDED*/
+	int n, size;	/*number of nodes, number of allocated nodes*/
+	int *level;	/*level[i] is the level of node i, levels for the terminal nodes*/
+	int *arity;	/*arity[i] is the number of children of node i different from MDD_FALSE*/
+	int **digit, **child;	/*child[i][j] is the child of node i for the digit digit[i][j], the digits increase with j (NULL for the terminal nodes)*/
+	struct hashmap *unique;	/*maps the INT vectors (level, arity, digits and children) to the node indices plus 1*/
+};
+
+mdd *NewMdd(int levels, const int *radix); /*Creates new MDD with the terminal nodes only for the given levels and numbers of digits*/
+void DeleteMdd(mdd *m); /*Deletes given MDD*/
+int MddNode(mdd *m, int l, const int *child); /*Returns the node of the bounded level l whose child for digit d is child[d], or the child if all children are equal*/
+int MddSparseNode(mdd *m, int l, int k, const int *digit, const int *child); /*Returns the node of level l whose child for the digit digit[j] is child[j] for j < k, where the digits increase, and MDD_FALSE for the other digits*/
+int MddChild(const mdd *m, int a, int l, int d); /*Returns the child of node a for digit d of level l, which is a itself if a is of a greater level*/
+int MddFromRows(mdd *m, const int *lev, int k, int *const *row, int count); /*Returns the node of the set of assignments that give level lev[j] the digit row[i][j] for j = 0,..., k-1 and some i < count, every unbounded level must occur in lev*/
+int MddAnd(mdd *m, int a, int b); /*Returns the node of the intersection of the sets of nodes a and b*/
+int MddOr(mdd *m, int a, int b); /*Returns the node of the union of the sets of nodes a and b*/
+int MddMinus(mdd *m, int a, int b); /*Returns the node of the difference of the sets of nodes a and b*/
+uint64_t MddCount(const mdd *m, int a); /*Returns the number of assignments in the set of node a*/
+int MddEnumerate(const mdd *m, int a, int (*visit)(const int digit[], void *data), void *data); /*Calls visit for every assignment digit[0],..., digit[levels-1] in the set of node a, in lexicographic order, until visit returns 0, returns the number of calls*/
+
+#endif
@@ -0,0 +1,43 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File minimize.h
+
+With the option --minimize, the locations of each program graph are merged up to bisimilarity 
+before the HDA is constructed: two locations are equivalent if both or neither are the final 
+location and, for every outgoing transition of one of them, the other one has an outgoing 
+transition with the same guard and action whose end location is equivalent to the end location 
+of the first transition. The HDA of the minimized program graphs is the quotient of the original 
+one by the induced identification of global states. This file declares the minimization 
+function.
+************************************************************************************************/
+
+#ifndef MINIMIZE_H
+#define MINIMIZE_H
+
+struct programgraph;
+
+int MinimizePG(struct programgraph *pg); /*Merges the bisimilar locations of pg into one location each and removes the duplicate transitions arising from this, returns the number of merged locations*/
+
+#endif
@@ -55,6 +55,10 @@ particular, functions to allocate and free memory.
 
 struct vector;
 struct list;
+struct array;
+struct bytecode;
+struct exprdag;
+struct evaltable;
 
 typedef struct intvar intvar;	/*integer variable*/
 typedef struct location location;
@@ -87,23 +91,32 @@ struct condition {
 	ast *exp;	/*boolean expression*/
 	struct list *varlist;	/*variables*/
 	struct list *evallist;	/*list of those evaluations of the variables under which the condition is true*/		
+	struct evaltable *table;	/*table of the evaluations (--old, see evaltable.h), NULL if not tabulated*/
+	struct bytecode *code;	/*compiled expression, NULL if not compiled*/
+	int node;	/*node of the expression in the expression DAG (see exprdag.h), -1 if not entered*/
 	int no_vars;	/*number of variables*/ 
 	char id[STRL];	/*name*/
 };
 struct assignment {
 	intvar *var;
 	ast *exp;
+	struct bytecode *code;	/*compiled expression, NULL if not compiled*/
+	int slot;	/*position of var in the valuations if the expression is compiled*/
+	int node;	/*node of the expression in the expression DAG, -1 if not entered, in particular if the expression reads a variable assigned before in the same action*/
 };
 struct action {		
 	struct list *varlist;	/*variables*/
 	struct list *assignments;	/*assignments that compose the action*/
 	int no_vars, no_evals, **map[2]; 	/*number of variables, number of evaluations, map: effect function for evaluations*/	
+	struct evaltable *table;	/*table of the evaluations map[0] (--old), NULL if not tabulated*/
 	char id[STRL];	/*name*/			
 };
 struct transition {
    	location *loc[2];	/*start and end location*/
 	condition *cond;	/*guard condition*/
 	action *act;		
+	int (*guard)(const int *vals);	/*native guard on the values of the variables, NULL if not generated (see codegen.h)*/
+	void (*effect)(const int *in, int *out);	/*native effect, NULL if not generated*/
 };
 struct programgraph {	
 	struct list *varlist;	/*variables*/
@@ -114,6 +127,8 @@ struct programgraph {
 	condition *cond_0, *cond_1;	/*initial and final condition*/
 	char id[STRL];	/*name*/	
 	int no_vars, no_acts, no_trans; /*numbers of variables, actions, transitions*/
+	int no_deadtrans, no_deadlocs;	/*numbers of transitions and locations removed by PrunePG*/
+	int no_mergedlocs, no_mergedtrans;	/*numbers of locations and transitions removed by MinimizePG (see minimize.h)*/
 };
 
 intvar *NewVariable(int d);	/*Creates new variable of domain size d*/
@@ -133,11 +148,16 @@ void DeleteTransition(void *trans);	/*Deletes given transition*/
 programgraph *NewPG(); /*Creates new program graph*/
 void DeletePG(void *pg); /*Deletes given program graph*/
 ast *CopyAst(const ast *exp); /*Copies ast*/
-int Evaluate(const ast *exp, const struct list *varlist, const struct vector *vals); /*Evaluates expression*/
+int Evaluate(const ast *exp, const struct array *vars, const struct vector *vals); /*Evaluates expression*/
 void AstName(char *name, const ast *exp);	/*Computes a string representation of an expression*/
 void ActionName(char *name, const action *act);	/*Computes the name of an action*/
-int CheckCondition(const struct vector *vec, const condition *cond, const struct list *varlist); /*Returns 1 if vector satisfies condition and 0 otherwise*/
-condition *MergeConditions(const condition *cond1, const condition *cond2); /*Merges conditions*/ 
-void ExtendCondition(const condition *cond, condition *newcond, const struct list *varlist); /*Extends condition cond to larger list of variables varlist, result is in newcond*/
-void Effect(const action *act, const struct vector *invec, struct vector *outvec, const struct list *varlist); /*Computes the effect of the action on invec, result is in outvec*/
+int CheckCondition(const struct vector *vec, const condition *cond, const struct array *vars, struct exprdag *dag); /*Returns 1 if vector satisfies condition and 0 otherwise, the values cached in dag (if not NULL) must belong to vec*/
+void Effect(const action *act, const struct vector *invec, struct vector *outvec, const struct array *vars, struct exprdag *dag); /*Computes the effect of the action on invec, result is in outvec, the values cached in dag (if not NULL) must belong to invec*/
+void RemoveTransition(programgraph *pg, transition *trans); /*Removes the transition from pg and its locations and deletes it*/
+int FoldAst(const ast *exp, int *val); /*Returns 1 and stores the value of the expression in val if the expression is constant, returns 0 otherwise, a division by zero is not folded*/
+void SimplifyAst(ast *exp); /*Replaces the constant arithmetic subexpressions (type NUMEXP) of the expression by numbers*/
+void PrunePG(programgraph *pg); /*Folds the constant arithmetic in the expressions of pg, removes the transitions whose guards are constant and never satisfied as well as the locations (except the final one) that are not reachable from the initial location*/
+void EnterPG(programgraph *pg, const struct array *vars, struct exprdag *dag); /*Enters the guards and the assignments of the program graph in dag, except the assignments reading a variable assigned before in the same action*/
+void CompilePG(programgraph *pg, const struct array *vars, const struct exprdag *dag); /*Compiles the guards, the final condition and the assignments of the program graph into bytecode over the variables in vars, the guards and assignments entered in dag by EnterPG() cache the values of their shared subexpressions*/
+void TabulatePG(programgraph *pg, const struct array *vars); /*Tabulates the evaluations of the guards, the final condition and the actions of the program graph given in the input format of the first versions (--old) over the variables in vars*/
 #endif	
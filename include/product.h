@@ -0,0 +1,51 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File product.h
+
+A product iterator enumerates the index tuples (idx[0],..., idx[k-1]) with 0 <= idx[i] < n[i] of a 
+cartesian product of k finite factors in lexicographic order, the last index changing fastest, 
+without materializing the product. An optional predicate is applied to every prefix as soon as 
+its last index is set; a prefix that fails the predicate is not extended. This file defines 
+product iterators and declares functions for them.
+************************************************************************************************/
+
+#ifndef PRODUCT_H
+#define PRODUCT_H
+
+typedef struct productiter productiter;
+
+struct productiter {
+	int k;	/*number of factors*/
+	const int *n;	/*n[i] is the number of elements of factor i*/
+	int *idx;	/*current index tuple*/
+	int (*accept)(const int idx[], int len, void *data);	/*predicate on the prefix idx[0],..., idx[len-1] (NULL if all tuples are accepted)*/
+	void *data;	/*data passed to accept*/
+	int state;	/*0 before the first tuple, 1 while iterating, 2 after the last tuple*/
+};
+
+void InitProductiter(productiter *it, int k, const int n[], int idx[], int (*accept)(const int [], int, void *), void *data); /*Initializes it for the product of k factors of sizes n[0],..., n[k-1], the index tuples are stored in the caller's array idx of length k*/
+int NextTuple(productiter *it); /*Sets it->idx to the next index tuple all of whose prefixes are accepted and returns 1, returns 0 if there is no further tuple*/
+
+#endif
@@ -0,0 +1,47 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File symbolic.h
+
+The symbolic count (--symbolic-count) computes the numbers of states, edges and deadlocks of the 
+HDA model without constructing it. A global state is an assignment of an MDD (see mdd.h) with an 
+unbounded level for the location of every process and for every variable. Every transition of a 
+program graph is a transition group, which reads and writes the level of the location of its 
+process and the levels of the variables of its guard and its action. The relation of a group 
+between the values of these levels before and after the transition is learned from the guard 
+and the effect of the transition for the projections of the states found so far, and the 
+reachable states are computed by breadth-first image computation with these relations. This 
+file declares the function for the symbolic count.
+************************************************************************************************/
+
+#ifndef SYMBOLIC_H
+#define SYMBOLIC_H
+
+struct vector;
+struct array;
+
+void SymbolicCount(const struct vector *pgvec, const struct array *vars); /*Computes and prints the numbers of states, edges and deadlocks of the HDA of the system of program graphs in pgvec over the variables in vars*/
+
+#endif
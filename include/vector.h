@@ -42,5 +42,8 @@ vector *NewVector(unsigned int dim, unsigned int elsize); /*Creates new vector o
 void DeleteVector(void *vec); /*Deletes given vector*/
 int VecCmp(const vector *vec1, const vector *vec2, int type, int (*cmp)(const void *, const void *)); /*Returns 0 iff the vectors of the given type are equal according to the coordinate comparison function cmp*/
 int Veccmp(const void *vec1, const void *vec2); /*Same as VecCmp((vector *) vec1, (vector *) vec2, INT, NULL)*/
+void InitVectorKernels(void); /*Selects the best kernels supported by the processor for IntVecEqual and IntVecHash, must be called before any threads are started*/
+int IntVecEqual(const vector *vec1, const vector *vec2); /*Returns 1 iff the INT vectors are equal*/
+unsigned int IntVecHash(const vector *vec); /*Hash value of the INT vector*/
 
 #endif
@@ -0,0 +1,130 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File array.c
+
+This file implements the functions declared in array.h. The number of slots is doubled when an 
+array is full, so that appending takes amortized constant time.
+************************************************************************************************/
+
+#include "array.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "list.h"
+
+
+#define ARRAY_MINSIZE 16	/*number of slots allocated for the first element*/
+
+
+/*Function implementations*/
+
+/*Initializes a as an empty array*/
+
+void InitArray(array *a) {
+
+	a->n = 0;
+	a->size = 0;
+	a->el = NULL;
+}
+
+
+/*Frees the memory of the elements of a, deletes the elements using the del function unless it is NULL, and makes a empty*/
+
+void ClearArray(array *a, void (*del)(void *)) {
+
+	unsigned int i;
+
+	if (del)
+		for (i = 0; i < a->n; i++)
+			del(a->el[i]);
+	free(a->el);
+	InitArray(a);
+}
+
+
+/*Creates new empty array*/
+
+array *NewArray(void) {
+
+	array *a;
+
+	if ((a = malloc(sizeof(array))) == NULL) {
+		printf("NewArray: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	InitArray(a);
+	return a;
+}
+
+
+/*Deletes array, deletes elements using the del function unless it is NULL*/
+
+void DeleteArray(array *a, void (*del)(void *)) {
+
+	if (a) {
+		ClearArray(a, del);
+		free(a);
+	}
+}
+
+
+/*Appends p to the array*/
+
+void AppendToArray(array *a, void *p) {
+
+	if (a->n == a->size) {
+		a->size = a->size ? 2 * a->size : ARRAY_MINSIZE;
+		if ((a->el = realloc(a->el, sizeof(void *) * a->size)) == NULL) {
+			printf("AppendToArray: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	a->el[a->n++] = p;
+}
+
+
+/*Sorts the elements by cmp, which is given pointers to two elements as in qsort*/
+
+void SortArray(array *a, int (*cmp)(const void *, const void *)) {
+
+	if (a->n > 1)
+		qsort(a->el, a->n, sizeof(void *), cmp);
+}
+
+
+/*Creates an array with the elements of the list in the same order*/
+
+array *ListToArray(const list *l) {
+
+	array *a = NewArray();
+	const list *node;
+
+	if ((node = l)) {
+		do {
+			AppendToArray(a, node->data);
+			node = node->next;
+		} while (node != l);
+	}
+	return a;
+}
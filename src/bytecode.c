@@ -0,0 +1,284 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File bytecode.c
+
+This file implements the functions declared in bytecode.h.
+************************************************************************************************/
+
+#include "bytecode.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "pgraph.h"
+#include "array.h"
+#include "exprdag.h"
+
+
+enum {BC_NUM, BC_VAR, BC_PLUS, BC_MINUS, BC_NEG, BC_TIMES, BC_DIV, BC_MOD, BC_EQ, BC_NEQ, BC_L, BC_LEQ, BC_G, BC_GEQ, BC_NOT, BC_BOOL, BC_AND, BC_OR, BC_LOAD, BC_STORE};	/*operations, BC_AND and BC_OR jump to arg if the top of the stack decides the result and pop it otherwise, BC_LOAD pushes the cached value of the node of the BC_STORE at position arg and jumps behind it if the value is cached, BC_STORE caches the top of the stack as the value of node arg*/
+
+
+/*Function prototypes*/
+
+static int Size(const ast *exp); /*Returns the number of nodes of the expression*/
+static int Slot(const intvar *var, const array *vars); /*Returns the position of var in vars, -1 if it is not in vars*/
+static void Emit(bytecode *code, int op, int arg, int push, int *sp); /*Appends an instruction that changes the current stack depth sp by push*/
+static int EmitNode(bytecode *code, const ast *exp, const array *vars, const exprdag *dag, int *sp); /*Appends the instructions for the root of the expression to code, whose operands are appended by EmitAst(), returns 0 if the expression cannot be compiled and 1 otherwise*/
+static int EmitAst(bytecode *code, const ast *exp, const array *vars, const exprdag *dag, int *sp); /*Appends the instructions for the expression to code, caching the subexpressions shared in dag (if not NULL), sp is the current stack depth, returns 0 if the expression cannot be compiled and 1 otherwise*/
+
+
+/*Function implementations*/
+
+/*Returns the number of nodes of the expression*/
+
+static int Size(const ast *exp) {
+
+	return exp ? 1 + Size(exp->l) + Size(exp->r) : 0;
+}
+
+
+/*Returns the position of var in vars, -1 if it is not in vars*/
+
+static int Slot(const intvar *var, const array *vars) {
+
+	unsigned i;
+
+	if (vars)
+		for (i = 0; i < vars->n; i++) 
+			if (vars->el[i] == var)
+				return i;
+	return -1;
+}
+
+
+/*Appends an instruction that changes the current stack depth sp by push*/
+
+static void Emit(bytecode *code, int op, int arg, int push, int *sp) {
+
+	code->in[code->n].op = op;
+	code->in[code->n].arg = arg;
+	code->n++;
+	*sp += push;
+	if (*sp > code->depth)
+		code->depth = *sp;
+}
+
+
+/*Appends the instructions for the root of the expression to code, whose operands are appended by EmitAst(), returns 0 if the expression cannot be compiled and 1 otherwise*/
+
+static int EmitNode(bytecode *code, const ast *exp, const array *vars, const exprdag *dag, int *sp) {
+
+	static const int binop[] = {0, BC_PLUS, BC_MINUS, BC_TIMES, BC_DIV, BC_MOD, BC_EQ, BC_NEQ, BC_L, BC_LEQ, BC_G, BC_GEQ};
+	int val, jump;
+
+	if (FoldAst(exp, &val)) 
+		Emit(code, BC_NUM, val, 1, sp);
+	else if (!exp || exp->type == NUM)
+		return 0;
+	else if (exp->type == VAR) {
+		if ((val = Slot(exp->node.var, vars)) < 0)
+			return 0;
+		Emit(code, BC_VAR, val, 1, sp);
+	}
+	else if (exp->node.op == AND || exp->node.op == OR) {
+/*the jump leaves the deciding value on the stack, otherwise it is popped and the right operand decides*/
+		if (!EmitAst(code, exp->l, vars, dag, sp))
+			return 0;
+		jump = code->n;
+		Emit(code, exp->node.op == AND ? BC_AND : BC_OR, 0, -1, sp);
+		if (!EmitAst(code, exp->r, vars, dag, sp))
+			return 0;
+		Emit(code, BC_BOOL, 0, 0, sp);
+		code->in[jump].arg = code->n;
+	}
+	else if (exp->node.op == NOT || (exp->node.op == MINUS && !exp->l)) {
+		if (!EmitAst(code, exp->r, vars, dag, sp))
+			return 0;
+		Emit(code, exp->node.op == NOT ? BC_NOT : BC_NEG, 0, 0, sp);
+	}
+	else if (exp->node.op >= PLUS && exp->node.op <= GEQ) {
+		if (!EmitAst(code, exp->l, vars, dag, sp) || !EmitAst(code, exp->r, vars, dag, sp))
+			return 0;
+		Emit(code, binop[exp->node.op], 0, -1, sp);
+	}
+	else
+		return 0;
+	return 1;
+}
+
+
+/*Appends the instructions for the expression to code, caching the subexpressions shared in dag (if not NULL), sp is the current stack depth, returns 0 if the expression cannot be compiled and 1 otherwise*/
+
+static int EmitAst(bytecode *code, const ast *exp, const array *vars, const exprdag *dag, int *sp) {
+
+	int node, jump;
+
+	if (!dag || !exp || exp->type == NUM || exp->type == VAR || (node = FindInExprdag(dag, exp, vars)) < 0 || dag->node[node].refs < 2) 
+		return EmitNode(code, exp, vars, dag, sp);
+/*the code of the shared subexpression is skipped if its value is cached*/
+	jump = code->n;
+	Emit(code, BC_LOAD, 0, 0, sp);
+	if (!EmitNode(code, exp, vars, dag, sp))
+		return 0;
+	code->in[jump].arg = code->n;
+	Emit(code, BC_STORE, node, 0, sp);
+	return 1;
+}
+
+
+/*Compiles the expression over the variables in vars, caching the values of the subexpressions shared in dag unless it is NULL, returns NULL if the expression is NULL or contains a variable not in vars*/
+
+bytecode *CompileAst(const ast *exp, const array *vars, const exprdag *dag) {
+
+	bytecode *code;
+	int sp = 0;
+
+/*every node yields at most four instructions*/
+	if ((code = malloc(sizeof(bytecode))) == NULL || (code->in = malloc(sizeof(instruction) * (4 * Size(exp) + 1))) == NULL) {
+		printf("CompileAst: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	code->n = code->depth = 0;
+	if (!EmitAst(code, exp, vars, dag, &sp)) {
+		DeleteBytecode(code);
+		return NULL;
+	}
+	return code;
+}
+
+
+/*Deletes given bytecode*/
+
+void DeleteBytecode(void *code) {
+
+	bytecode *c;
+
+	if (code) {
+		c = (bytecode *) code;
+		free(c->in);
+		free(c);
+	}
+}
+
+
+/*Evaluates the compiled expression for the values vals of the variables, the values cached in dag (if not NULL) must belong to vals*/
+
+int RunBytecode(const bytecode *code, const int *vals, exprdag *dag) {
+
+	int stack[code->depth], sp = -1;
+	const instruction *in = code->in, *end = code->in + code->n;
+
+	while (in < end) {
+		switch (in->op) {
+			case BC_NUM:
+				stack[++sp] = in->arg;
+				break;
+			case BC_VAR:
+				stack[++sp] = vals[in->arg];
+				break;
+			case BC_PLUS:
+				sp--;
+				stack[sp] = stack[sp] + stack[sp + 1];
+				break;
+			case BC_MINUS:
+				sp--;
+				stack[sp] = stack[sp] - stack[sp + 1];
+				break;
+			case BC_NEG:
+				stack[sp] = - stack[sp];
+				break;
+			case BC_TIMES:
+				sp--;
+				stack[sp] = stack[sp] * stack[sp + 1];
+				break;
+			case BC_DIV:
+				sp--;
+				stack[sp] = stack[sp] / stack[sp + 1];
+				break;
+			case BC_MOD:
+				sp--;
+				stack[sp] = stack[sp] % stack[sp + 1];
+				break;
+			case BC_EQ:
+				sp--;
+				stack[sp] = stack[sp] == stack[sp + 1];
+				break;
+			case BC_NEQ:
+				sp--;
+				stack[sp] = stack[sp] != stack[sp + 1];
+				break;
+			case BC_L:
+				sp--;
+				stack[sp] = stack[sp] < stack[sp + 1];
+				break;
+			case BC_LEQ:
+				sp--;
+				stack[sp] = stack[sp] <= stack[sp + 1];
+				break;
+			case BC_G:
+				sp--;
+				stack[sp] = stack[sp] > stack[sp + 1];
+				break;
+			case BC_GEQ:
+				sp--;
+				stack[sp] = stack[sp] >= stack[sp + 1];
+				break;
+			case BC_NOT:
+				stack[sp] = !stack[sp];
+				break;
+			case BC_BOOL:
+				stack[sp] = stack[sp] != 0;
+				break;
+			case BC_AND:
+				if (stack[sp] == 0) {
+					in = &code->in[in->arg];
+					continue;
+				}
+				sp--;
+				break;
+			case BC_OR:
+				if (stack[sp] != 0) {
+					stack[sp] = 1;
+					in = &code->in[in->arg];
+					continue;
+				}
+				sp--;
+				break;
+			case BC_LOAD:
+				if (dag && dag->mark[code->in[in->arg].arg] == dag->stamp) {
+					stack[++sp] = dag->val[code->in[in->arg].arg];
+					in = &code->in[in->arg + 1];
+					continue;
+				}
+				break;
+			case BC_STORE:
+				if (dag) {
+					dag->mark[in->arg] = dag->stamp;
+					dag->val[in->arg] = stack[sp];
+				}
+				break;
+		}
+		in++;
+	}
+	return stack[0];
+}
@@ -0,0 +1,257 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File codegen.c
+
+This file implements the functions declared in codegen.h. Transition k of the generated code has 
+the guard g<k> and the effect e<k>, and the table pg2hda_native lists them in the order of the 
+transitions of the program graphs. Guards and effects that have not been compiled to bytecode 
+(see bytecode.h) are not generated and remain interpreted. The compiler is given by the 
+environment variable CC and defaults to cc.
+************************************************************************************************/
+
+#include "codegen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dlfcn.h>
+#include "def.h"
+#include "vector.h"
+#include "list.h"
+#include "array.h"
+#include "pgraph.h"
+
+
+typedef struct nativetrans nativetrans;
+
+struct nativetrans {	/*same layout as the entries of pg2hda_native*/
+	int (*guard)(const int *vals);
+	void (*effect)(const int *in, int *out);
+};
+
+
+/*Function prototypes*/
+
+static int HasEffect(const transition *trans); /*Returns 1 if all assignments of the action of the transition are compiled and 0 otherwise*/
+static void WriteExp(FILE *fp, const ast *exp, const array *vars); /*Writes the expression as a C expression over the array v of values*/
+static void WriteTransition(FILE *fp, const transition *trans, int k, const array *vars); /*Writes the guard and the effect of transition k*/
+static void WriteSource(FILE *fp, const vector *pgvec, const array *vars); /*Writes the C source for the transitions of the program graphs*/
+
+
+/*Function implementations*/
+
+/*Returns 1 if all assignments of the action of the transition are compiled and 0 otherwise*/
+
+static int HasEffect(const transition *trans) {
+
+	const list *alist;
+
+	if (!trans->act)
+		return 0;
+	if ((alist = trans->act->assignments)) {
+		do {
+			if (!((assignment *) alist->data)->code)
+				return 0;
+			alist = alist->next;
+		} while (alist != trans->act->assignments);
+	}
+	return 1;
+}
+
+
+/*Writes the expression as a C expression over the array v of values*/
+
+static void WriteExp(FILE *fp, const ast *exp, const array *vars) {
+
+	static const char *const opname[] = {"", "+", "-", "*", "/", "%", "==", "!=", "<", "<=", ">", ">=", "||", "&&"};
+	unsigned i;
+
+	if (exp->type == NUM) 
+		fprintf(fp, "(%d)", exp->node.num);
+	else if (exp->type == VAR) {
+		for (i = 0; vars->el[i] != exp->node.var; i++)
+			;
+		fprintf(fp, "v[%u]", i);
+	}
+	else if (exp->node.op == NOT || (exp->node.op == MINUS && !exp->l)) {
+		fprintf(fp, exp->node.op == NOT ? "(!" : "(-");
+		WriteExp(fp, exp->r, vars);
+		fprintf(fp, ")");
+	}
+	else {
+		fprintf(fp, "(");
+		WriteExp(fp, exp->l, vars);
+		fprintf(fp, " %s ", opname[exp->node.op]);
+		WriteExp(fp, exp->r, vars);
+		fprintf(fp, ")");
+	}
+}
+
+
+/*Writes the guard and the effect of transition k*/
+
+static void WriteTransition(FILE *fp, const transition *trans, int k, const array *vars) {
+
+	const list *alist;
+	const assignment *ass;
+
+	if (trans->cond->code) {
+		fprintf(fp, "static int g%d(const int *v) {\n\treturn ", k);
+		WriteExp(fp, trans->cond->exp, vars);
+		fprintf(fp, ";\n}\n");
+	}
+	if (HasEffect(trans)) {
+		fprintf(fp, "static void e%d(const int *in, int *v) {\n", k);
+		if (vars->n > 0)
+			fprintf(fp, "\tmemcpy(v, in, sizeof(int) * %u);\n", vars->n);
+		if ((alist = trans->act->assignments)) {
+			do {
+				ass = (assignment *) alist->data;
+				fprintf(fp, "\tv[%d] = ", ass->slot);
+				WriteExp(fp, ass->exp, vars);
+				fprintf(fp, ";\n");
+				alist = alist->next;
+			} while (alist != trans->act->assignments);
+		}
+		fprintf(fp, "}\n");
+	}
+}
+
+
+/*Writes the C source for the transitions of the program graphs*/
+
+static void WriteSource(FILE *fp, const vector *pgvec, const array *vars) {
+
+	const programgraph *const *const pg = pgvec->coord;
+	const list *tlist;
+	const transition *trans;
+	int i, k, n = 0;
+
+	fprintf(fp, "#include <string.h>\n\n");
+	for (i = 0; i < pgvec->dim; i++) {
+		if ((tlist = pg[i]->translist)) {
+			do {
+				WriteTransition(fp, (transition *) tlist->data, n++, vars);
+				tlist = tlist->next;
+			} while (tlist != pg[i]->translist);
+		}
+	}
+	fprintf(fp, "\nconst struct {int (*guard)(const int *); void (*effect)(const int *, int *);} pg2hda_native[] = {\n");
+	for (i = 0, k = 0; i < pgvec->dim; i++) {
+		if ((tlist = pg[i]->translist)) {
+			do {
+				trans = (transition *) tlist->data;
+				if (trans->cond->code)
+					fprintf(fp, "\t{g%d, ", k);
+				else 
+					fprintf(fp, "\t{0, ");
+				if (HasEffect(trans))
+					fprintf(fp, "e%d},\n", k);
+				else 
+					fprintf(fp, "0},\n");
+				k++;
+				tlist = tlist->next;
+			} while (tlist != pg[i]->translist);
+		}
+	}
+	fprintf(fp, "\t{0, 0}\n};\n");
+}
+
+
+/*Generates and compiles native code for the transitions of the program graphs in pgvec over the variables in vars and sets the native functions of the transitions, returns the handle of the loaded shared object or NULL if the code could not be compiled or loaded*/
+
+void *LoadNativeCode(const vector *pgvec, const array *vars) {
+
+	const programgraph *const *const pg = pgvec->coord;
+	const char *tmp = getenv("TMPDIR"), *cc = getenv("CC");
+	char dir[STRL], src[STRL + 16], obj[STRL + 16], cmd[4 * STRL];
+	const nativetrans *native;
+	const list *tlist;
+	transition *trans;
+	void *handle = NULL;
+	FILE *fp;
+	int i, k;
+
+	snprintf(dir, STRL, "%s/pg2hdaXXXXXX", tmp && *tmp ? tmp : "/tmp");
+	if (!mkdtemp(dir)) {
+		fprintf(stderr, "Code generation: cannot create a temporary directory, using the interpreter\n");
+		return NULL;
+	}
+	sprintf(src, "%s/native.c", dir);
+	sprintf(obj, "%s/native.so", dir);
+	if ((fp = fopen(src, "w"))) {
+		WriteSource(fp, pgvec, vars);
+		fclose(fp);
+		snprintf(cmd, sizeof(cmd), "%s -shared -fPIC -O2 -w -o '%s' '%s' > /dev/null 2>&1", cc && *cc ? cc : "cc", obj, src);
+		if (system(cmd) == 0) 
+			handle = dlopen(obj, RTLD_NOW | RTLD_LOCAL);
+	}
+	remove(src);
+	remove(obj);
+	rmdir(dir);
+	if (!handle || !(native = dlsym(handle, "pg2hda_native"))) {
+		if (handle)
+			dlclose(handle);
+		fprintf(stderr, "Code generation: compiling or loading the native code failed, using the interpreter\n");
+		return NULL;
+	}
+	for (i = 0, k = 0; i < pgvec->dim; i++) {
+		if ((tlist = pg[i]->translist)) {
+			do {
+				trans = (transition *) tlist->data;
+				trans->guard = native[k].guard;
+				trans->effect = native[k].effect;
+				k++;
+				tlist = tlist->next;
+			} while (tlist != pg[i]->translist);
+		}
+	}
+	return handle;
+}
+
+
+/*Resets the native functions of the transitions of the program graphs in pgvec and unloads the shared object*/
+
+void UnloadNativeCode(void *handle, const vector *pgvec) {
+
+	const programgraph *const *const pg = pgvec->coord;
+	const list *tlist;
+	transition *trans;
+	int i;
+
+	if (handle) {
+		for (i = 0; i < pgvec->dim; i++) {
+			if ((tlist = pg[i]->translist)) {
+				do {
+					trans = (transition *) tlist->data;
+					trans->guard = NULL;
+					trans->effect = NULL;
+					tlist = tlist->next;
+				} while (tlist != pg[i]->translist);
+			}
+		}
+		dlclose(handle);
+	}
+}
@@ -0,0 +1,107 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File corners.c
+
+This file implements the functions declared in corners.h. The vertices of a cube of degree d >= 1 
+are obtained from those of its faces d[0][0] and d[1][0], which are already in the table.
+************************************************************************************************/
+
+#include "corners.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "array.h"
+#include "cube.h"
+
+
+/*Function implementations*/
+
+/*Computes the vertices of all cubes of degree at most dim of HDA cubelist*/
+
+cornertable *NewCornertable(array *const cubelist[], unsigned int dim) {
+
+	cornertable *ct;
+	unsigned int d, i, j, n;
+	cube **vertsc, *const *v0c, *const *v1c;
+	const cube *pc;
+
+	if ((ct = malloc(sizeof(cornertable))) == NULL || (ct->count = malloc(sizeof(unsigned int) * (dim + 1))) == NULL || (ct->vert = malloc(sizeof(cube **) * (dim + 1))) == NULL) {
+		printf("NewCornertable: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	ct->dim = dim;
+	for (d = 0; d <= dim; d++) {
+		ct->count[d] = cubelist[d]->n;
+		n = 1u << d;
+		if ((ct->vert[d] = malloc(sizeof(cube *) * n * (ct->count[d] > 0 ? ct->count[d] : 1))) == NULL) {
+			printf("NewCornertable: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (j = 0; j < ct->count[d]; j++) {
+			pc = (cube *) cubelist[d]->el[j];
+			vertsc = ct->vert[d] + pc->id * n;
+			if (d == 0) 
+				vertsc[0] = (cube *) pc;
+			else if (d == 1) {
+				vertsc[0] = pc->d[0][0];
+				vertsc[1] = pc->d[1][0];
+			}
+			else {
+				v0c = CubeVertices(ct, pc->d[0][0]);
+				v1c = CubeVertices(ct, pc->d[1][0]);
+				for (i = 0; i < n / 4; i++) {
+					vertsc[4 * i] = v0c[2 * i];
+					vertsc[4 * i + 1] = v1c[2 * i + 1];
+					vertsc[4 * i + 2] = v0c[2 * i + 1];
+					vertsc[4 * i + 3] = v1c[2 * i];
+				}
+			}
+		}
+	}
+	return ct;
+}
+
+
+/*Deletes the given corner table (but not the cubes)*/
+
+void DeleteCornertable(cornertable *ct) {
+
+	unsigned int d;
+
+	if (ct) {
+		for (d = 0; d <= ct->dim; d++) 
+			free(ct->vert[d]);
+		free(ct->vert);
+		free(ct->count);
+		free(ct);
+	}
+}
+
+
+/*Returns the 2^k vertices of the cube pc of degree k <= ct->dim without allocating memory, the initial and the final vertex come first*/
+
+cube *const *CubeVertices(const cornertable *ct, const cube *pc) {
+
+	return ct->vert[pc->degree] + pc->id * (1u << pc->degree);
+}
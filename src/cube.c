@@ -28,25 +28,57 @@ This file implements the functions declared in cube.h.
 ************************************************************************************************/
 
 #include "cube.h"
-#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "def.h"
 #include "vector.h"
-#include "list.h"
+#include "array.h"
+#include "cubeset.h"
+#include "cubeindex.h"
+#include "product.h"
+
+
+/*Sort keys for the faces at an edge*/
+
+typedef struct pidkey pidkey;
+
+struct pidkey {
+	const int *pid;	/*tuple of process IDs*/
+	int len;	/*length of the tuple*/
+	int face;	/*index of the face in the array of faces*/
+};
+
+
+/*Candidate for a new cube whose opposite faces of the faces of a configuration are chosen by a product iterator*/
+
+typedef struct candidate candidate;
+
+struct candidate {
+	cube *pc;	/*the candidate, whose boundary is completed face by face*/
+	int edgeindex;	/*index of the top and bottom faces*/
+	const int *upperindex;	/*upper indexes of the faces of the configuration*/
+	const cubeset *oppset;	/*oppset[i] contains the possible opposite faces of face i of the configuration*/
+};
 
 
 /*Function prototypes*/
 
-static vector *MergeVertices(const vector *v0, const vector *v1, int dim); /*Computes the vertices of a cube of degree dim >= 1 by joining the vertices of a front face (v0) and those of the corresponding back face (v1), the initial and the final vertex come first*/	
-static int FillSquares(cube *edge, list *cubelist[]); /*Completes HDA by introducing squares at given 1-cube, returns the number of squares added*/	
-static list *ExtendConfig(const vector *v2d, int edgeindex, int degree, const int pid[], const list *veclist, cube *const faces[]); /*See below*/	
-static list *Config(const cube *edge, int degree, const list *veclist, cube *const faces[]); /*See below*/	
-static list *CompleteUpperindices(int edgeindex, cube *const faces[], const vector *v, const int upperindex[]);	/*See below*/
-static list *Upperindices(int edgeindex, cube *const faces[], const vector *v);	/*See below*/
-static int BdIdsOK(const cube *pc); /*Returns 1 if cube satisfies the boundary identities and 0 else*/
-static int FillHDCubes(cube *edge, list *cubelist[], int degree, int facecount);	
+static int FillSquares(cube *edge, array *cubelist[], cubeindex *index); /*Completes HDA by introducing squares at given 1-cube, returns the number of squares added*/	
+static int Pidkeycmp(const void *k1, const void *k2); /*Compares pid keys lexicographically, keys with equal pid tuples are ordered by their face indexes*/
+static int SamePids(const pidkey *pk1, const pidkey *pk2); /*Returns 1 if the pid tuples of the two keys are equal and 0 otherwise*/
+static int FindPidkey(const pidkey keys[], int n, const int pid[]); /*Returns the first position in the sorted array keys of length n whose pid tuple is not smaller than pid*/
+static void ExtendConfig(const int v2d[], int edgeindex, int degree, const int pid[], const pidkey full[], int facecount, int **config, int *n, int *cap); /*See below*/	
+static int *Config(const cube *edge, int degree, int facecount, cube *const faces[], int *n); /*See below*/	
+static int NextPair(int degree, const unsigned int compat[], int p, int upperindex[]); /*See below*/
+static int FirstUpperindex(int edgeindex, cube *const faces[], const int vc[], int degree, unsigned int compat[], int upperindex[]); /*See below*/
+static int NextUpperindex(int degree, const unsigned int compat[], int upperindex[]); /*Sets upperindex to the upper index vector following upperindex in the enumeration started by FirstUpperindex() and returns 1, returns 0 if upperindex is the last vector*/
+static int BdIdPairOK(const cube *pc, int i, int j); /*Returns 1 if the faces d[k][i] and d[l][j] (i < j) of cube satisfy the boundary identities d[k][i] d[l][j-1] = d[l][j] d[k][i] and 0 else*/
+static int OppositeFaceOK(const int idx[], int len, void *data); /*Predicate of the product of opposite faces: sets the opposite face len-1 of the candidate data and returns 1 if the boundary identities between this face (or its opposite) and the faces set before hold, 0 otherwise*/
+static int FillHDCubes3(cube *edge, array *cubelist[], cubeindex *index, int degree, int facecount); /*Kernel of FillHDCubes() for degree 3, instantiated from hdcubes.h*/
+static int FillHDCubes4(cube *edge, array *cubelist[], cubeindex *index, int degree, int facecount); /*Kernel of FillHDCubes() for degree 4, instantiated from hdcubes.h*/
+static int FillHDCubesN(cube *edge, array *cubelist[], cubeindex *index, int degree, int facecount); /*Generic kernel of FillHDCubes(), instantiated from hdcubes.h*/
+static int FillHDCubes(cube *edge, array *cubelist[], cubeindex *index, int degree, int facecount);	
 
 
 /*Function implementations*/
@@ -168,6 +200,7 @@ cube *NewCube(unsigned int d) {
       		exit(EXIT_FAILURE);
    	}
 	pc->degree = d;	
+	pc->id = 0;
 	pc->flags.ini = 0;
 	pc->flags.fin = 0;	
 	if (d > 0) {
@@ -188,23 +221,22 @@ cube *NewCube(unsigned int d) {
 		pc->d[0] = NULL;
 		pc->d[1] = NULL;		
 	}		
-   	if ((pc->s[0] = malloc(sizeof(list *) * (d + 1))) == NULL) {
+   	if ((pc->s[0] = malloc(sizeof(cubeset) * (d + 1))) == NULL) {
       		printf ("NewCube: Out of memory!\n");
       		exit(EXIT_FAILURE);
    	}	
-	if ((pc->s[1] = malloc(sizeof(list *) * (d + 1))) == NULL) {
+	if ((pc->s[1] = malloc(sizeof(cubeset) * (d + 1))) == NULL) {
       		printf ("NewCube: Out of memory!\n");
       		exit(EXIT_FAILURE);
    	}
 	for (i = 0; i < d + 1; i++) {
-		pc->s[0][i] = NULL;
-		pc->s[1][i] = NULL;
+		InitCubeset(&pc->s[0][i]);
+		InitCubeset(&pc->s[1][i]);
 	}
 	pc->edges = NewVector(d, sizeof(cube *));
    	if (d == 1) 
 		((cube **) pc->edges->coord)[0] = pc;
 	pc->lab = NULL;
-	pc->cl = NULL;
 	pc->furtherdata = NULL;		
 	return pc;
 }
@@ -226,8 +258,8 @@ void DeleteCube(void *pc) {
 		}	
 		DeleteVector(c->edges);	
 		for (i = 0; i < c->degree + 1; i++) {
-			DeleteList(&c->s[0][i], NULL);
-			DeleteList(&c->s[1][i], NULL);
+			ClearCubeset(&c->s[0][i]);
+			ClearCubeset(&c->s[1][i]);
 		}
 		free(c->s[0]);
 		free(c->s[1]);
@@ -240,708 +272,454 @@ void DeleteCube(void *pc) {
 }
 
 
-/*Computes the vertices of a cube of degree dim >= 1 by joining the vertices of a front face (v0) and those of the corresponding back face (v1), the initial and the final vertex come first*/
-
-static vector *MergeVertices(const vector *v0, const vector *v1, int dim) {
-
-	vector *verts;
-	cube **vertsc, **v0c = v0->coord, **v1c = v1->coord;
-	unsigned int i, n;
-	
-	n = (unsigned int) pow(2, dim);
-	verts = NewVector(n, sizeof(cube *));
-	vertsc = verts->coord;
-	if (dim == 1) {
-		vertsc[0] = v0c[0];
-		vertsc[1] = v1c[0];
-    }
-	else 
-		for(i = 0; i < n / 4; i++) {
-			vertsc[4 * i] = v0c[2 * i];
-			vertsc[4 * i + 1] = v1c[2 * i + 1];
-			vertsc[4 * i + 2] = v0c[2 * i + 1];
-			vertsc[4 * i + 3] = v1c[2 * i];
-		}	
-	return verts;
-}
-
-
-/*Computes the vertices of a cube, the initial and the final vertex come first*/
-
-vector *Vertices(cube *pc) {
-
-	vector *verts, *verts0, *verts1;
-	
-	if (pc->degree == 0) { 
-		verts = NewVector(1, sizeof(cube *));
-		((cube **) verts->coord)[0] = pc;
-	}
-	else { 
-		verts0 = Vertices(pc->d[0][0]);
-		verts1 = Vertices(pc->d[1][0]);
-		verts = MergeVertices(verts0, verts1, pc->degree);
-		DeleteVector(verts0);
-		DeleteVector(verts1);
-	}
-	return verts;
-}
-
-
-/*Computes the edges of pc starting in the initial vertex of pc*/
-
-vector *Edges(cube *pc) {
+/*Appends pc to the array of cubes of its degree in cubelist and numbers it accordingly*/
 
-	vector *edges = NewVector(pc->degree, sizeof(cube *)), *e, *f;
-	cube **edgesc = edges->coord;
-	int i;
+void InsertCube(cube *pc, array *cubelist[]) {
 
-	if (pc->degree == 1) 		
-		edgesc[0] = pc;	
-	else if (pc->degree == 2) {		
-		edgesc[0] = pc->d[0][1];
-		edgesc[1] = pc->d[0][0];	
-	}
-	else if (pc->degree > 2) {
-		e = Edges(pc->d[0][pc->degree - 1]);
-		f = Edges(pc->d[0][pc->degree - 3]);
-		for (i = 0; i < pc->degree - 1; i++) 
-			edgesc[i] = ((cube **) e->coord)[i];
-		edgesc[pc->degree - 1] = ((cube **) f->coord)[pc->degree - 2];
-		DeleteVector(e);
-		DeleteVector(f);			 			
-	}
-	return edges;
+	pc->id = cubelist[pc->degree]->n;
+	AppendToArray(cubelist[pc->degree], pc);
 }
 
 
 /*Completes HDA by introducing squares at given 1-cube, returns the number of squares added*/
 
-static int FillSquares(cube *edge, list *cubelist[]) {
+static int FillSquares(cube *edge, array *cubelist[], cubeindex *index) {
 	
 	int squarecount = 0;
-	list *clist, *clist2, *clist3;
+	unsigned int i, i2, i3;
+	const cubeset *cs, *cs2, *cs3;
 	cube *pc, *pc2, *pc3, *newcube;
 	label **pclabc, **edgelabc = (label **) edge->lab->coord;
 
 /*squares with edge as a d[0]-boundary*/
-	if (edge->d[0][0]->s[0][0]) {
-		clist = edge->d[0][0]->s[0][0];
-		do {
-			pc = (cube *) clist->data;
-			pclabc = (label **) pc->lab->coord; 
-			if (edge->d[1][0]->s[0][0] && pclabc[0]->num != edgelabc[0]->num) {
-				clist2 = edge->d[1][0]->s[0][0];
-				do {
-					pc2 = (cube *) clist2->data;
-					if (pc->d[1][0]->s[0][0] && VecCmp(pc2->lab ,pc->lab, PTR, Labcmp) == 0) {
-						clist3 = pc->d[1][0]->s[0][0];
-						do{
-							pc3 = (cube *) clist3->data;
-							if (pc2->d[1][0] == pc3->d[1][0] && VecCmp(edge->lab, pc3->lab, PTR, Labcmp) == 0) {
-								newcube = NewCube(2);								
-								if (pclabc[0]->num < edgelabc[0]->num) {
-									newcube->d[0][0] = edge;
-									edge->s[0][0] = InsertElement(newcube, edge->s[0][0]);
-									newcube->d[0][1] = pc;
-									pc->s[0][1] = InsertElement(newcube, pc->s[0][1]);
-									newcube->d[1][0] = pc3;
-									pc3->s[1][0] = InsertElement(newcube, pc3->s[1][0]);
-									newcube->d[1][1] = pc2;
-									pc2->s[1][1] = InsertElement(newcube, pc2->s[1][1]);
-								}
-								else {							
-									newcube->d[0][0] = pc;
-									pc->s[0][0] = InsertElement(newcube, pc->s[0][0]);
-									newcube->d[0][1] = edge;
-									edge->s[0][1] = InsertElement(newcube, edge->s[0][1]);
-									newcube->d[1][0] = pc2;
-									pc2->s[1][0] = InsertElement(newcube, pc2->s[1][0]);
-									newcube->d[1][1] = pc3;
-									pc3->s[1][1] = InsertElement(newcube, pc3->s[1][1]);	
-								}								
-								((cube **) newcube->edges->coord)[0] = newcube->d[0][1];
-								((cube **) newcube->edges->coord)[1] = newcube->d[0][0];																
-								cubelist[2] = InsertElement(newcube, cubelist[2]);								
-								newcube->cl = cubelist[2]->prev;
-								squarecount++;					
+	cs = &edge->d[0][0]->s[0][0];
+	for (i = 0; i < cs->n; i++) {
+		pc = CubesetCubes(cs)[i];
+		pclabc = (label **) pc->lab->coord; 
+		if (pclabc[0]->num != edgelabc[0]->num) {
+			cs2 = &edge->d[1][0]->s[0][0];
+			for (i2 = 0; i2 < cs2->n; i2++) {
+				pc2 = CubesetCubes(cs2)[i2];
+				if (VecCmp(pc2->lab ,pc->lab, PTR, Labcmp) == 0) {
+					cs3 = &pc->d[1][0]->s[0][0];
+					for (i3 = 0; i3 < cs3->n; i3++) {
+						pc3 = CubesetCubes(cs3)[i3];
+						if (pc2->d[1][0] == pc3->d[1][0] && VecCmp(edge->lab, pc3->lab, PTR, Labcmp) == 0) {
+							newcube = NewCube(2);
+							InsertCube(newcube, cubelist);								
+							if (pclabc[0]->num < edgelabc[0]->num) {
+								newcube->d[0][0] = edge;
+								AddToCubeset(&edge->s[0][0], newcube);
+								newcube->d[0][1] = pc;
+								AddToCubeset(&pc->s[0][1], newcube);
+								newcube->d[1][0] = pc3;
+								AddToCubeset(&pc3->s[1][0], newcube);
+								newcube->d[1][1] = pc2;
+								AddToCubeset(&pc2->s[1][1], newcube);
 							}
-							clist3 = clist3->next;
-						} while (clist3 != pc->d[1][0]->s[0][0]);
+							else {							
+								newcube->d[0][0] = pc;
+								AddToCubeset(&pc->s[0][0], newcube);
+								newcube->d[0][1] = edge;
+								AddToCubeset(&edge->s[0][1], newcube);
+								newcube->d[1][0] = pc2;
+								AddToCubeset(&pc2->s[1][0], newcube);
+								newcube->d[1][1] = pc3;
+								AddToCubeset(&pc3->s[1][1], newcube);	
+							}								
+							((cube **) newcube->edges->coord)[0] = newcube->d[0][1];
+							((cube **) newcube->edges->coord)[1] = newcube->d[0][0];
+							AddToCubeindex(index, newcube);																
+							squarecount++;					
+						}
 					}
-					clist2 = clist2->next;
-				} while (clist2 != edge->d[1][0]->s[0][0]);
+				}
 			}
-			clist = clist->next;
-		} while (clist != edge->d[0][0]->s[0][0]);
+		}
 	}	 	
 /*squares with edge as a d[1]-boundary*/
-	if (edge->d[1][0]->s[1][0]) {
-		clist = edge->d[1][0]->s[1][0];
-		do {
-			pc = (cube *) clist->data;
-			pclabc = (label **) pc->lab->coord;
-			if (edge->d[0][0]->s[1][0] && pclabc[0]->num != edgelabc[0]->num) {
-				clist2 = edge->d[0][0]->s[1][0];
-				do{
-					pc2 = (cube *) clist2->data;
-					if (pc->d[0][0]->s[1][0] && VecCmp(pc2->lab, pc->lab, PTR, Labcmp) == 0) {
-						clist3 = pc->d[0][0]->s[1][0];
-						do{
-							pc3 = (cube *) clist3->data;
-							if (pc3 != edge && pc2->d[0][0] == pc3->d[0][0] && VecCmp(edge->lab, pc3->lab, PTR, Labcmp) == 0) {
-								newcube = NewCube(2);								
-								if (pclabc[0]->num < edgelabc[0]->num) {
-									newcube->d[0][0] = pc3;
-									pc3->s[0][0] = InsertElement(newcube, pc3->s[0][0]);
-									newcube->d[0][1] = pc2;
-									pc2->s[0][1] = InsertElement(newcube, pc2->s[0][1]);
-									newcube->d[1][0] = edge;
-									edge->s[1][0] = InsertElement(newcube, edge->s[1][0]);
-									newcube->d[1][1] = pc;
-									pc->s[1][1] = InsertElement(newcube, pc->s[1][1]);	
-								}
-								else{								
-									newcube->d[0][0] = pc2;
-									pc2->s[0][0] = InsertElement(newcube, pc2->s[0][0]);
-									newcube->d[0][1] = pc3;
-									pc3->s[0][1] = InsertElement(newcube, pc3->s[0][1]);
-									newcube->d[1][0] = pc;
-									pc->s[1][0] = InsertElement(newcube, pc->s[1][0]);
-									newcube->d[1][1] = edge;
-									edge->s[1][1] = InsertElement(newcube, edge->s[1][1]);	
-								}
-								((cube **) newcube->edges->coord)[0] = newcube->d[0][1];
-								((cube **) newcube->edges->coord)[1] = newcube->d[0][0];								
-								cubelist[2] = InsertElement(newcube, cubelist[2]);								
-								newcube->cl = cubelist[2]->prev;
-								squarecount++;					
+	cs = &edge->d[1][0]->s[1][0];
+	for (i = 0; i < cs->n; i++) {
+		pc = CubesetCubes(cs)[i];
+		pclabc = (label **) pc->lab->coord;
+		if (pclabc[0]->num != edgelabc[0]->num) {
+			cs2 = &edge->d[0][0]->s[1][0];
+			for (i2 = 0; i2 < cs2->n; i2++) {
+				pc2 = CubesetCubes(cs2)[i2];
+				if (VecCmp(pc2->lab, pc->lab, PTR, Labcmp) == 0) {
+					cs3 = &pc->d[0][0]->s[1][0];
+					for (i3 = 0; i3 < cs3->n; i3++) {
+						pc3 = CubesetCubes(cs3)[i3];
+						if (pc3 != edge && pc2->d[0][0] == pc3->d[0][0] && VecCmp(edge->lab, pc3->lab, PTR, Labcmp) == 0) {
+							newcube = NewCube(2);
+							InsertCube(newcube, cubelist);								
+							if (pclabc[0]->num < edgelabc[0]->num) {
+								newcube->d[0][0] = pc3;
+								AddToCubeset(&pc3->s[0][0], newcube);
+								newcube->d[0][1] = pc2;
+								AddToCubeset(&pc2->s[0][1], newcube);
+								newcube->d[1][0] = edge;
+								AddToCubeset(&edge->s[1][0], newcube);
+								newcube->d[1][1] = pc;
+								AddToCubeset(&pc->s[1][1], newcube);	
+							}
+							else{								
+								newcube->d[0][0] = pc2;
+								AddToCubeset(&pc2->s[0][0], newcube);
+								newcube->d[0][1] = pc3;
+								AddToCubeset(&pc3->s[0][1], newcube);
+								newcube->d[1][0] = pc;
+								AddToCubeset(&pc->s[1][0], newcube);
+								newcube->d[1][1] = edge;
+								AddToCubeset(&edge->s[1][1], newcube);	
 							}
-							clist3 = clist3->next;
-						} while (clist3 != pc->d[0][0]->s[1][0]);
+							((cube **) newcube->edges->coord)[0] = newcube->d[0][1];
+							((cube **) newcube->edges->coord)[1] = newcube->d[0][0];
+							AddToCubeindex(index, newcube);								
+							squarecount++;					
+						}
 					}
-					clist2 = clist2->next;
-				} while (clist2 != edge->d[0][0]->s[1][0]);
+				}
 			}
-			clist = clist->next;
-		} while (clist != edge->d[1][0]->s[1][0]);
+		}
 	}
 	return squarecount;	 	
 } 
 
 
-/*At a fixed edge, suppose that all cubes of dimension degree-1 (all containing the edge) have been constructed, that they have been put in the faces array, and that veclist represents the indexes of the faces (as 1D vectors). Suppose that the 2D vector v2d contains the indexes of two faces that from the point of view of process IDs could be part of the boundary of a cube of dimension degree. Suppose that edgeindex is the lower index of the starting edge of that cube that is parallel to the edge under consideration, and suppose that the cube's pid is given by pid. ExtendConfig() returns the list of all face index vectors beginning with v2d representing degree-1 faces that from the point of view of process IDs could be part of the boundary of the cube.*/
-
-static list *ExtendConfig(const vector *v2d, int edgeindex, int degree, const int pid[], const list *veclist, cube *const faces[]) {
-
-	list *config = NULL, *product, *dlist = NULL;
-	const list *vlist;
-	int d, i, j;
-	vector *v, *copy = NewVector(2, sizeof(int)), *vec = NewVector(degree - 1, sizeof(int)), *hat = NewVector(degree - 1, sizeof(int));
-
-	((int *) copy->coord)[0] = ((int *) v2d->coord)[0];
-	((int *) copy->coord)[1] = ((int *) v2d->coord)[1];
-	config = InsertElement(copy, config);
-	for (d = 2; d < degree - 1 && config; d++) {
-		if (veclist) {
-			vlist = veclist;
-			do {
-				v = (vector *) vlist->data;		
-				for (j = 0; j < degree - 1; j++)
-					((int *) vec->coord)[j] = ((label **) ((cube **) faces[((int *) v->coord)[0]]->edges->coord)[j]->lab->coord)[0]->num;
-				i = d < edgeindex ? d : d + 1;
-				for (j = 0; j < i; j++)
-					((int *) hat->coord)[j] = pid[j];
-				for (j = i; j < degree - 1; j++)
-					((int *) hat->coord)[j] = pid[j+1];				
-				if (Veccmp(hat, vec) == 0) 
-					dlist = InsertElement(v, dlist);				
-				vlist = vlist->next;
-			} while (vlist != veclist);
-		}
-		product = Product(config, dlist, INT);
-		DeleteList(&config, DeleteVector);
-		DeleteList(&dlist, NULL);
-		config = product;			
+/*Compares pid keys lexicographically, keys with equal pid tuples are ordered by their face indexes*/
+
+static int Pidkeycmp(const void *k1, const void *k2) {
+
+	const pidkey *pk1 = k1, *pk2 = k2;
+	int i;
+
+	for (i = 0; i < pk1->len; i++) 
+		if (pk1->pid[i] != pk2->pid[i]) 
+			return pk1->pid[i] < pk2->pid[i] ? -1 : 1;
+	return (pk1->face > pk2->face) - (pk1->face < pk2->face);
+}
+
+
+/*Returns 1 if the pid tuples of the two keys are equal and 0 otherwise*/
+
+static int SamePids(const pidkey *pk1, const pidkey *pk2) {
+
+	return memcmp(pk1->pid, pk2->pid, sizeof(int) * pk1->len) == 0;
+}
+
+
+/*Returns the first position in the sorted array keys of length n whose pid tuple is not smaller than pid*/
+
+static int FindPidkey(const pidkey keys[], int n, const int pid[]) {
+
+	int lo = 0, hi = n, mid, i;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		for (i = 0; i < keys[mid].len && keys[mid].pid[i] == pid[i]; i++)
+			;
+		if (i < keys[mid].len && keys[mid].pid[i] < pid[i])
+			lo = mid + 1;
+		else
+			hi = mid;
 	}
-	DeleteVector(hat);
-	DeleteVector(vec);
-	return config;	
+	return lo;
 }
 
 
-/*At the given edge, suppose that all cubes of dimension degree-1 (all containing edge) have been constructed, that they have been put in the faces array, and that veclist represents the indexes of the faces (as 1D vectors). Config() returns the list of all face index vectors representing degree-1 faces that from the point of view of process IDs could be part of the boundary of a cube of dimension degree.*/
-
-static list *Config(const cube *edge, int degree, const list *veclist, cube *const faces[]) {
-
-	vector *v, *vec = NewVector(degree - 1, sizeof(int)), *hat = NewVector(degree - 1, sizeof(int));
-	int i, j, d, maybe, edgeindex, pid[degree], *vc;	
-	list *config = NULL, *product, *helpconfig;
-	const list *vlist;
-		
-	product = Product(veclist, veclist, INT);
-	if (product) {
-		vlist = product;
-		do {	
-			v = (vector *) vlist->data;
-			vc = v-> coord;	
-			maybe = 1;
-			for (i = 0; i < degree - 1; i++) {
-				if (((label **) ((cube **) faces[vc[0]]->edges->coord)[i]->lab->coord)[0]->num == ((label **) edge->lab->coord)[0]->num) {
-					edgeindex = i;
-					break;
-				}
-			}	
-			if (edgeindex == 0 && ((label **) ((cube **) faces[vc[1]]->edges->coord)[0]->lab->coord)[0]->num == ((label **) edge->lab->coord)[0]->num) {	
-				if (((label **) ((cube **) faces[vc[1]]->edges->coord)[1]->lab->coord)[0]->num == ((label **) ((cube **) faces[vc[0]]->edges->coord)[1]->lab->coord)[0]->num) 
-					maybe = 0;
-				else {
-					pid[0] = ((label **) edge->lab->coord)[0]->num;				
-					pid[1] = ((label **) ((cube **) faces[vc[1]]->edges->coord)[1]->lab->coord)[0]->num;	
-					for (i = 2; i < degree; i++) 
-						pid[i] = ((label **) ((cube **) faces[vc[0]]->edges->coord)[i - 1]->lab->coord)[0]->num;					
-				}		
-			}	
-			else {
-				if (((label **) ((cube **) faces[vc[1]]->edges->coord)[0]->lab->coord)[0]->num >= ((label **) ((cube **) faces[vc[0]]->edges->coord)[0]->lab->coord)[0]->num) 
-					maybe = 0;						
-				else {	
-					edgeindex += 1;
-						pid[0] = ((label **) ((cube **) faces[vc[1]]->edges->coord)[0]->lab->coord)[0]->num;
-					for (i = 1; i < degree; i++) 
-						pid[i] = ((label **) ((cube **) faces[vc[0]]->edges->coord)[i - 1]->lab->coord)[0]->num;
-				}			
-			}
-			for (d = 0; d <= 1 && maybe; d++) {
-				for (j = 0; j < degree - 1; j++)
-					((int *) vec->coord)[j] = ((label **) ((cube **) faces[vc[d]]->edges->coord)[j]->lab->coord)[0]->num;
-				i = d < edgeindex ? d : d + 1;					
-				for (j = 0; j < i; j++)
-					((int *) hat->coord)[j] = pid[j];
-				for (j = i; j < degree - 1; j++)
-					((int *) hat->coord)[j] = pid[j + 1];
-				if (Veccmp(hat, vec) != 0) 
-					maybe = 0;						
-			}																						
-			if (maybe) {			
-				helpconfig = ExtendConfig(v, edgeindex, degree, pid, veclist, faces);
-				ConcatLists(&config, helpconfig); 
-				DeleteList(&helpconfig, NULL);
+/*At a fixed edge, suppose that all cubes of dimension degree-1 (all containing the edge) have been constructed, that they have been put in the faces array, and that the array full of length facecount contains the keys of the faces for their pid tuples, sorted by Pidkeycmp. Suppose that v2d contains the indexes of two faces that from the point of view of process IDs could be part of the boundary of a cube of dimension degree. Suppose that edgeindex is the lower index of the starting edge of that cube that is parallel to the edge under consideration, and suppose that the cube's pid is given by pid. ExtendConfig() appends all face index vectors of length degree-1 beginning with v2d representing degree-1 faces that from the point of view of process IDs could be part of the boundary of the cube to the array *config, which holds *n vectors and has room for *cap of them.*/
+
+static void ExtendConfig(const int v2d[], int edgeindex, int degree, const int pid[], const pidkey full[], int facecount, int **config, int *n, int *cap) {
+
+	int d, i, j, more = 1, hat[degree - 1], lo[degree - 1], hi[degree - 1], size[degree - 1], idx[degree - 1], *v;
+	productiter it;
+
+/*the faces with the right pids for the positions 2,..., degree-2 form a range of full*/
+	for (d = 2; d < degree - 1 && more; d++) {
+		i = d < edgeindex ? d : d + 1;
+		for (j = 0; j < i; j++)
+			hat[j] = pid[j];
+		for (j = i; j < degree - 1; j++)
+			hat[j] = pid[j + 1];
+		lo[d] = FindPidkey(full, facecount, hat);
+		for (hi[d] = lo[d]; hi[d] < facecount && memcmp(full[hi[d]].pid, hat, sizeof(int) * (degree - 1)) == 0; hi[d]++)
+			;
+		size[d - 2] = hi[d] - lo[d];
+		more = hi[d] > lo[d];
+	}
+	if (!more)
+		return;
+/*all combinations, the last position changes fastest*/
+	InitProductiter(&it, degree - 3, size, idx, NULL, NULL);
+	while (NextTuple(&it)) {
+		if (*n == *cap) {
+			*cap = *cap ? 2 * *cap : 16;
+			if ((*config = realloc(*config, sizeof(int) * (degree - 1) * *cap)) == NULL) {
+				printf("ExtendConfig: Out of memory!\n");
+				exit(EXIT_FAILURE);
 			}
-			vlist = vlist->next;
-		} while (vlist != product);
-		DeleteList(&product, DeleteVector);
+		}
+		v = &(*config)[*n * (degree - 1)];
+		(*n)++;
+		v[0] = v2d[0];
+		v[1] = v2d[1];
+		for (d = 2; d < degree - 1; d++)
+			v[d] = full[lo[d] + idx[d - 2]].face;
 	}
-	DeleteVector(hat);
-	DeleteVector(vec);	
-	return config;
 }
 
 
-/*At a fixed edge, suppose that all cubes of dimension degree-1 (all containing the edge) have been constructed and that they have been put in the faces array. Suppose that the vector v contains the indexes of degree-1 faces that from the point of view of process IDs could be part of the boundary of a cube of dimension degree. Suppose that edgeindex is the lower index of the starting edge of that cube that is parallel to the edge under consideration, and suppose that the upper indexes corresponding to the two first faces are given by upperindex. CompleteUpperindices() computes the list of all possible upper index vectors for the given configuration of faces that begin with upperindex.*/
+/*At the given edge, suppose that all cubes of dimension degree-1 (all containing edge) have been constructed and that they have been put in the faces array of length facecount. Config() returns an array of the *n face index vectors of length degree-1 representing degree-1 faces that from the point of view of process IDs could be part of the boundary of a cube of dimension degree, stored one after the other. The faces are bucketed by their pid tuples without the smallest pid different from the pid of edge, so that only faces of the same bucket are paired.*/
 
-static list *CompleteUpperindices(int edgeindex, cube *const faces[], const vector *v, const int upperindex[]) {
+static int *Config(const cube *edge, int degree, int facecount, cube *const faces[], int *n) {
 
-	int  i, j, *vc = v->coord;
-	const int degree = v->dim + 1;	
-	list *veclist = NULL, *vlist = NULL, *product;
-	vector *vec, *vec2;
+	const int e = ((label **) edge->lab->coord)[0]->num, k = degree - 1;
+	int a, b, i, j, p, q, r, edgeindex, cap = 0, pid[degree], v2d[2], *pidtab, *redtab, *rem, *pos, *first, *last, *config = NULL;
+	const int *pa, *pb;
+	pidkey *red, *full;
 
-	vec = NewVector(2, sizeof(int));
-	((int *) vec->coord)[0] = upperindex[0];
-	((int *) vec->coord)[1] = upperindex[1];
-	veclist = InsertElement(vec, veclist);
-	if (edgeindex == 0) {
-		for (i = 2; i < degree - 1 && veclist; i++) {
-			for (j = 0; j <= 1; j++) {					
-				if (faces[vc[0]]->d[j][i] == faces[vc[i]]->d[upperindex[0]][1]) {				
-					vec2 = NewVector(1, sizeof(int));
-					((int *) vec2->coord)[0] = j;
-					vlist = InsertElement(vec2, vlist);
-				}
+	*n = 0;
+	if ((pidtab = malloc(sizeof(int) * facecount * k)) == NULL || (redtab = malloc(sizeof(int) * facecount * (k - 1))) == NULL || (rem = malloc(sizeof(int) * facecount)) == NULL 
+		|| (pos = malloc(sizeof(int) * facecount)) == NULL || (first = malloc(sizeof(int) * facecount)) == NULL || (last = malloc(sizeof(int) * facecount)) == NULL
+		|| (red = malloc(sizeof(pidkey) * facecount)) == NULL || (full = malloc(sizeof(pidkey) * facecount)) == NULL) {
+		printf("Config: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+/*pid tuples of the faces and the reduced tuples (without the smallest pid different from e)*/
+	for (i = 0; i < facecount; i++) {
+		for (j = 0; j < k; j++) 
+			pidtab[i * k + j] = ((label **) ((cube **) faces[i]->edges->coord)[j]->lab->coord)[0]->num;
+		r = pidtab[i * k] == e ? 1 : 0;
+		rem[i] = pidtab[i * k + r];
+		for (j = 0, p = 0; j < k; j++) 
+			if (j != r)
+				redtab[i * (k - 1) + p++] = pidtab[i * k + j];
+		full[i].pid = &pidtab[i * k];
+		full[i].len = k;
+		full[i].face = i;
+		red[i].pid = &redtab[i * (k - 1)];
+		red[i].len = k - 1;
+		red[i].face = i;
+	}
+	qsort(full, facecount, sizeof(pidkey), Pidkeycmp);
+	qsort(red, facecount, sizeof(pidkey), Pidkeycmp);
+	for (p = 0; p < facecount; p++) {
+		pos[red[p].face] = p;
+		first[p] = p > 0 && SamePids(&red[p - 1], &red[p]) ? first[p - 1] : p;
+	}
+	for (p = facecount - 1; p >= 0; p--) 
+		last[p] = p + 1 < facecount && SamePids(&red[p], &red[p + 1]) ? last[p + 1] : p + 1;
+/*pairs of faces of the same bucket*/
+	for (a = 0; a < facecount; a++) {
+		pa = &pidtab[a * k];
+		p = pos[a];
+		for (q = first[p]; q < last[p]; q++) {
+			b = red[q].face;
+			pb = &pidtab[b * k];
+			if (pa[0] == e ? rem[b] == rem[a] : rem[b] >= rem[a]) 
+				continue;
+			if (pa[0] == e && pb[0] == e) {
+				edgeindex = 0;
+				pid[0] = e;
+				pid[1] = pb[1];
+				for (i = 2; i < degree; i++) 
+					pid[i] = pa[i - 1];
+			}
+			else {
+				for (edgeindex = 0; pa[edgeindex] != e; edgeindex++)
+					;
+				edgeindex += 1;
+				pid[0] = pb[0];
+				for (i = 1; i < degree; i++) 
+					pid[i] = pa[i - 1];
 			}
-			product = Product(veclist, vlist, INT);
-			DeleteList(&veclist, DeleteVector);
-			DeleteList(&vlist, DeleteVector);
-			veclist = product;								
+			v2d[0] = a;
+			v2d[1] = b;
+			ExtendConfig(v2d, edgeindex, degree, pid, full, facecount, &config, n, &cap);
 		}
 	}
-	else if (edgeindex == 1) {
-		for (i = 2; i < degree - 1 && veclist; i++) {
-			for (j = 0; j<= 1; j++) {			
-				if (faces[vc[0]]->d[j][i] == faces[vc[i]]->d[upperindex[0]][0]) {				
-					vec2 = NewVector(1, sizeof(int));
-					((int *) vec2->coord)[0] = j;
-					vlist = InsertElement(vec2, vlist);
-				}
-			}					
-			product = Product(veclist, vlist, INT);
-			DeleteList(&veclist, DeleteVector);
-			DeleteList(&vlist, DeleteVector);
-			veclist = product;								
+	free(pidtab);
+	free(redtab);
+	free(rem);
+	free(pos);
+	free(first);
+	free(last);
+	free(red);
+	free(full);
+	return config;
+}
+
+
+/*Suppose that compat contains the compatibility masks computed by FirstUpperindex() for a configuration of faces of cubes of dimension degree-1. NextPair() sets upperindex to the first upper index vector for the configuration whose first two entries u0, u1 satisfy u0 + 2 * u1 > p and returns 1, it returns 0 if there is no such vector.*/
+
+static int NextPair(int degree, const unsigned int compat[], int p, int upperindex[]) {
+
+	int i;
+
+	for (p++; p < 4; p++) {
+		if (compat[0] & 1u << p) {
+			upperindex[0] = p & 1;
+			upperindex[1] = p >> 1;
+			for (i = 2; i < degree - 1 && compat[i] >> 2 * upperindex[0] & 3; i++)
+				upperindex[i] = compat[i] >> 2 * upperindex[0] & 1 ? 0 : 1;
+			if (i == degree - 1)
+				return 1;
 		}
 	}
-	else {
-		for (i = 2; i < edgeindex && veclist; i++) {
-			for (j = 0; j<= 1; j++) {			
-				if (faces[vc[0]]->d[j][i - 1] == faces[vc[i]]->d[upperindex[0]][0]) {				
-					vec2 = NewVector(1, sizeof(int));
-					((int *) vec2->coord)[0] = j;
-					vlist = InsertElement(vec2, vlist);
-				}
-			}					
-			product = Product(veclist, vlist, INT);
-			DeleteList(&veclist, DeleteVector);
-			DeleteList(&vlist, DeleteVector);
-			veclist = product;								
-		}		
-		for (i = edgeindex; i < degree - 1 && veclist; i++) {
-			for (j = 0; j<= 1; j++) {							
-				if (faces[vc[0]]->d[j][i] == faces[vc[i]]->d[upperindex[0]][0]) {				
-					vec2 = NewVector(1, sizeof(int));
-					((int *) vec2->coord)[0] = j;
-					vlist = InsertElement(vec2, vlist);
-				}
-			}						
-			product = Product(veclist, vlist, INT);
-			DeleteList(&veclist, DeleteVector);
-			DeleteList(&vlist, DeleteVector);
-			veclist = product;								
-		}		
-	}
-	return veclist;
+	return 0;
 }
 
 
-/*At a fixed edge, suppose that all cubes of dimension degree-1 (all containing the edge) have been constructed and that they have been put in the faces array. Suppose that the vector v contains the indexes of degree-1 faces that from the point of view of process IDs could be part of the boundary of a cube of dimension degree, and suppose that edgeindex is the lower index of the starting edge of that cube that is parallel to the given edge. Upperindices() computes the list of all possible upper index vectors for the given configuration of faces.*/
+/*At a fixed edge, suppose that all cubes of dimension degree-1 (all containing the edge) have been constructed and that they have been put in the faces array. Suppose that the array vc of length degree-1 contains the indexes of degree-1 faces that from the point of view of process IDs could be part of the boundary of a cube of dimension degree, and suppose that edgeindex is the lower index of the starting edge of that cube that is parallel to the given edge. FirstUpperindex() computes the compatibility masks of the configuration in the array compat of length degree-1: bit u0 + 2 * u1 of compat[0] is set if the first two faces are compatible with the upper indexes u0 and u1, and for i >= 2, bit 2 * u0 + j of compat[i] is set if face i is compatible with the upper index j given u0. It then sets upperindex to the first possible upper index vector for the configuration and returns 1, it returns 0 if there is none. The further vectors are obtained by NextUpperindex().*/
 
-static list *Upperindices(int edgeindex, cube *const faces[], const vector *v) {
+static int FirstUpperindex(int edgeindex, cube *const faces[], const int vc[], int degree, unsigned int compat[], int upperindex[]) {
 
-	int  upperindex[2], *vc = v->coord;		
-	list *veclist, *upperindices = NULL;
+	int i, j, u0, u1;
+	const int p0 = edgeindex < 2 ? 1 : 0, p1 = edgeindex == 0 ? 1 : 0;
 
-	if (edgeindex == 0) {
-		if (faces[vc[0]]->d[0][1] == faces[vc[1]]->d[0][1]) {
-			upperindex[0] = 0;
-			upperindex[1] = 0;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
-		}
-		if (faces[vc[0]]->d[0][1] == faces[vc[1]]->d[1][1]) {
-			upperindex[0] = 1;
-			upperindex[1] = 0;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
-		}
-		if (faces[vc[0]]->d[1][1] == faces[vc[1]]->d[0][1]) {
-			upperindex[0] = 0;
-			upperindex[1] = 1;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
-		}
-		if (faces[vc[0]]->d[1][1] == faces[vc[1]]->d[1][1]) {
-			upperindex[0] = 1;
-			upperindex[1] = 1;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
-		}
+	compat[0] = 0;
+	for (u1 = 0; u1 <= 1; u1++) 
+		for (u0 = 0; u0 <= 1; u0++) 
+			if (faces[vc[0]]->d[u1][p0] == faces[vc[1]]->d[u0][p1]) 
+				compat[0] |= 1u << (u0 + 2 * u1);
+	for (i = 2; i < degree - 1; i++) {
+		compat[i] = 0;
+		for (u0 = 0; u0 <= 1; u0++) 
+			for (j = 0; j <= 1; j++) 
+				if (faces[vc[0]]->d[j][edgeindex < 2 || i >= edgeindex ? i : i - 1] == faces[vc[i]]->d[u0][p1]) 
+					compat[i] |= 1u << (2 * u0 + j);
 	}
-	else if (edgeindex == 1) {
-		if (faces[vc[0]]->d[0][1] == faces[vc[1]]->d[0][0]) {
-			upperindex[0] = 0;
-			upperindex[1] = 0;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
-		}
-		if (faces[vc[0]]->d[0][1] == faces[vc[1]]->d[1][0]) {
-			upperindex[0] = 1;
-			upperindex[1] = 0;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
-		}
-		if (faces[vc[0]]->d[1][1] == faces[vc[1]]->d[0][0]) {
-			upperindex[0] = 0;
-			upperindex[1] = 1;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
-		}
-		if (faces[vc[0]]->d[1][1] == faces[vc[1]]->d[1][0]) {
-			upperindex[0] = 1;
-			upperindex[1] = 1;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
+	return NextPair(degree, compat, -1, upperindex);
+}
+
+
+/*Sets upperindex to the upper index vector following upperindex in the enumeration started by FirstUpperindex() and returns 1, returns 0 if upperindex is the last vector*/
+
+static int NextUpperindex(int degree, const unsigned int compat[], int upperindex[]) {
+
+	int i, j;
+
+	for (i = degree - 2; i >= 2; i--) {
+		if (upperindex[i] == 0 && compat[i] >> 2 * upperindex[0] & 2) {
+			upperindex[i] = 1;
+			for (j = i + 1; j < degree - 1; j++)
+				upperindex[j] = compat[j] >> 2 * upperindex[0] & 1 ? 0 : 1;
+			return 1;
 		}
 	}
-	else {
-		if (faces[vc[0]]->d[0][0] == faces[vc[1]]->d[0][0]) {
-			upperindex[0] = 0;
-			upperindex[1] = 0;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
-		}
-		if (faces[vc[0]]->d[0][0] == faces[vc[1]]->d[1][0]) {
-			upperindex[0] = 1;
-			upperindex[1] = 0;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
-		}
-		if (faces[vc[0]]->d[1][0] == faces[vc[1]]->d[0][0]) {
-			upperindex[0] = 0;
-			upperindex[1] = 1;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
-		}
-		if (faces[vc[0]]->d[1][0] == faces[vc[1]]->d[1][0]) {
-			upperindex[0] = 1;
-			upperindex[1] = 1;
-			veclist = CompleteUpperindices(edgeindex, faces, v, upperindex);
-			ConcatLists(&upperindices, veclist);
-			DeleteList(&veclist, NULL);
-		}		
-	}		
-	return upperindices;
+	return NextPair(degree, compat, upperindex[0] + 2 * upperindex[1], upperindex);
+}
+
+
+/*Returns 1 if the faces d[k][i] and d[l][j] (i < j) of cube satisfy the boundary identities d[k][i] d[l][j-1] = d[l][j] d[k][i] and 0 else*/
+
+static int BdIdPairOK(const cube *pc, int i, int j) {
+
+	int k, l;
+
+	for (k = 0; k < 2; k++) 
+		for (l = 0; l < 2; l++) 
+			if (pc->d[k][i]->d[l][j-1] != pc->d[l][j]->d[k][i]) 
+				return 0;
+	return 1;
 }
 
 
 /*Returns 1 if cube satisfies the boundary identities and 0 else*/
 
-static int BdIdsOK(const cube *pc) {
+int BdIdsOK(const cube *pc) {
+
+	int ok = 1, i, j;
+	
+	for (i = 0; i < pc->degree - 1 && ok; i++) 
+		for (j = i + 1; j < pc->degree && ok; j++) 
+			ok = BdIdPairOK(pc, i, j);
+	return ok;
+} 
+
+
+/*Returns 1 if cube satisfies the boundary identities between its faces d[k][i] and d[l][j] with i, j != e and 0 else*/
+
+int BdIdsOKExcept(const cube *pc, int e) {
 
-	int ok = 1, i, j, k, l;
+	int ok = 1, i, j;
 	
 	for (i = 0; i < pc->degree - 1 && ok; i++) {
+		if (i == e)
+			continue;
 		for (j = i + 1; j < pc->degree && ok; j++) {
-			for (k = 0; k < 2 && ok; k++) {
-				for (l = 0; l < 2 && ok ; l++) {
-					if (pc->d[k][i]->d[l][j-1] != pc->d[l][j]->d[k][i]) 
-						ok = 0;															
-				} 				
-			}				
-		}	
+			if (j == e)
+				continue;
+			ok = BdIdPairOK(pc, i, j);
+		}
 	}
 	return ok;
 } 
 
 
+/*Predicate of the product of opposite faces: sets the opposite face len-1 of the candidate data and returns 1 if the boundary identities between this face (or its opposite) and the faces set before hold, 0 otherwise*/
+
+static int OppositeFaceOK(const int idx[], int len, void *data) {
+
+	const candidate *cd = data;
+	cube *const pc = cd->pc;
+	const int l = len - 1, p = l < cd->edgeindex ? l : l + 1;
+	int i;
+
+	pc->d[1 - cd->upperindex[l]][p] = CubesetCubes(&cd->oppset[l])[idx[l]];
+/*the faces set before have smaller indexes than p*/
+	for (i = 0; i < l; i++) 
+		if (!BdIdPairOK(pc, i < cd->edgeindex ? i : i + 1, p)) 
+			return 0;
+	return 1;
+}
+
+
+/*Kernels that complete HDA by introducing cubes of degree 3, degree 4, and any given degree >= 3 at given 1-cube, return the number of cubes added*/
+
+#define HD_KERNEL FillHDCubes3
+#define HD_DEGREE 3
+#include "hdcubes.h"
+
+#define HD_KERNEL FillHDCubes4
+#define HD_DEGREE 4
+#include "hdcubes.h"
+
+#define HD_KERNEL FillHDCubesN
+#define HD_DEGREE degree
+#include "hdcubes.h"
+
+
 /*Completes HDA by introducing cubes of given degree at given 1-cube, returns the number of cubes added*/
 
-static int FillHDCubes(cube *const edge, list *cubelist[], int degree, int facecount) {
+static int FillHDCubes(cube *const edge, array *cubelist[], cubeindex *index, int degree, int facecount) {
 
-	int  newcount = 0, i, j, *upperindex, edgeindex, *vc;
-	const int edgepid = ((label **) edge->lab->coord)[0]->num;
-	vector *v, *vec, *cubevec, *upvec, *facevec = NewVector(facecount, sizeof(cube *));	
-	cube **faces = facevec->coord, *top[2], *cub, **cubevecc;
-	list *clist, *toplist[2] = {NULL, NULL}, *tlist[2], *slist, *veclist = NULL, *config, *cubeveclist, *cveclist, *product, *intersection, *upperindices, *ulist, *others = NULL;
-	
-	if (degree > 2) {
-/*determine faces containing edge and their configurations with compatible pids*/
-		clist = cubelist[degree - 1]->prev;
-		for (i = 0; i < facecount; i++) {
-			faces[i] = (cube *) clist->data;
-			vec = NewVector(1, sizeof(int));
-			((int *) vec->coord)[0] = i;
-			veclist = InsertElement(vec, veclist);
-			clist = clist->prev;
-		}
-		config = Config(edge, degree, veclist, faces);
-		DeleteList(&veclist, DeleteVector);
-/*for each configuration of faces with compatible pids*/
-		if (config) {
-			veclist = config;
-			do {
-				v = (vector *) veclist->data;
-				vc = v->coord;
-/*determine edgeindex*/
-				for (i = 0; i < degree - 1; i++) {
-					if (((label **) ((cube **) faces[vc[0]]->edges->coord)[i]->lab->coord)[0]->num == edgepid) {	
-						edgeindex = i;
-						break;
-					}
-				}	
-				if (edgeindex > 0 || ((label **) ((cube **) faces[vc[1]]->edges->coord)[0]->lab->coord)[0]->num != edgepid) 
-					edgeindex += 1;	
-				upperindices = Upperindices(edgeindex, faces, v);
-/*for each vector of compatible upper indexes*/				
-				if (upperindices) {
-					ulist = upperindices; 
-					do {
-						upvec = (vector *) upperindices->data;
-						upperindex = upvec->coord;
-/*determine all possible top and bottom faces (wrt edge)*/ 
-						if (edgeindex > 0) {
-							for (i = 0; i < 2; i++) {
-								MergeLists(&toplist[i], faces[vc[0]]->d[i][edgeindex - 1]->s[upperindex[0]][0], NULL);
-								for (j = 1; j < edgeindex && toplist[i]; j++) {
-									intersection = Intersection(faces[vc[j]]->d[i][edgeindex - 1]->s[upperindex[j]][j], toplist[i], NULL);
-									DeleteList(&toplist[i], NULL);
-									toplist[i] = intersection;											
-								}
-								for (j = edgeindex; j < degree - 1 && toplist[i]; j++) {
-									intersection = Intersection(faces[vc[j]]->d[i][edgeindex]->s[upperindex[j]][j], toplist[i], NULL);
-									DeleteList(&toplist[i], NULL);
-									toplist[i] = intersection;									
-								}
-								if (!toplist[i]) 
-									break;
-							}								
-						}
-						else {
-							for (i = 0; i < 2; i++) {
-								MergeLists(&toplist[i], faces[vc[0]]->d[i][0]->s[upperindex[0]][0], NULL);
-								for (j = 1; j < degree - 1 && toplist[i]; j++) {
-									intersection = Intersection(faces[vc[j]]->d[i][0]->s[upperindex[j]][j], toplist[i], NULL);
-									DeleteList(&toplist[i], NULL);
-									toplist[i] = intersection;									
-								}
-								if (!toplist[i]) 
-									break;
-							}								
-						}
-/*for all possible top and bottom faces*/ 
-						if (toplist[0] && toplist[1]) {
-							tlist[0] = toplist[0];
-							do {
-								top[0] = (cube *) tlist[0]->data;
-								tlist[1] = toplist[1];
-								do {
-									top[1] = (cube *) tlist[1]->data;
-/*determine all vectors of possible opposite faces of the ones in the current configuration*/
-									if (edgeindex > 0) {
-										slist = Intersection(top[0]->d[1 - upperindex[0]][0]->s[0][edgeindex - 1], top[1]->d[1 - upperindex[0]][0]->s[1][edgeindex - 1], NULL);										
-										cubeveclist = AsVectorList(slist);
-										DeleteList(&slist, NULL);
-										for (j = 1; j < edgeindex && cubeveclist; j++) {
-											slist = Intersection(top[0]->d[1 - upperindex[j]][j]->s[0][edgeindex - 1], top[1]->d[1 - upperindex[j]][j]->s[1][edgeindex - 1], NULL);											
-											cveclist = AsVectorList(slist);
-											DeleteList(&slist, NULL);
-											product = Product(cubeveclist, cveclist, PTR);
-											DeleteList(&cubeveclist, DeleteVector);
-											DeleteList(&cveclist, DeleteVector);
-											cubeveclist = product;						
-										}										
-										for (j = edgeindex; j< degree - 1 && cubeveclist; j++) {
-											slist = Intersection(top[0]->d[1 - upperindex[j]][j]->s[0][edgeindex], top[1]->d[1 - upperindex[j]][j]->s[1][edgeindex], NULL);													
-											cveclist = AsVectorList(slist);
-											DeleteList(&slist, NULL);
-											product = Product(cubeveclist, cveclist, PTR);
-											DeleteList(&cubeveclist, DeleteVector);
-											DeleteList(&cveclist, DeleteVector);
-											cubeveclist = product;	
-										}										
-									}
-									else {
-										slist = Intersection(top[0]->d[1 - upperindex[0]][0]->s[0][0], top[1]->d[1 - upperindex[0]][0]->s[1][0], NULL);	
-										cubeveclist = AsVectorList(slist);
-										DeleteList(&slist, NULL);
-										for (j = 1; j < degree - 1 && cubeveclist; j++) {
-											slist = Intersection(top[0]->d[1 - upperindex[j]][j]->s[0][0], top[1]->d[1 - upperindex[j]][j]->s[1][0], NULL);			
-											cveclist = AsVectorList(slist);
-											DeleteList(&slist, NULL);
-											product = Product(cubeveclist, cveclist, PTR);
-											DeleteList(&cubeveclist, DeleteVector);
-											DeleteList(&cveclist, DeleteVector);
-											cubeveclist = product;	
-										}										
-									}
-/*for each vector of possible opposite faces of the ones in the current configuration*/
-									if (cubeveclist) {
-										cveclist = cubeveclist;
-										do {
-											cubevec = (vector *) cveclist->data;
-											cubevecc = cubevec->coord;
-/*create a new cube*/
-											cub = NewCube(degree);
-											cub->d[0][edgeindex] = top[0];			
-											cub->d[1][edgeindex] = top[1];
-											others = Intersection(top[0]->s[0][edgeindex], top[1]->s[1][edgeindex], NULL);
-											for (i = 0; i < edgeindex; i++) {
-												cub->d[upperindex[i]][i] = faces[vc[i]];
-												intersection = Intersection(others, faces[vc[i]]->s[upperindex[i]][i], NULL);
-												DeleteList(&others, NULL);
-												others = intersection;
-												cub->d[1 - upperindex[i]][i] = cubevecc[i];
-												intersection = Intersection(others, cubevecc[i]->s[1 - upperindex[i]][i], NULL);
-												DeleteList(&others, NULL);
-												others = intersection;
-											}
-											for (i = edgeindex; i < degree - 1; i++) {
-												cub->d[upperindex[i]][i + 1] = faces[vc[i]];
-												intersection = Intersection(others, faces[vc[i]]->s[upperindex[i]][i + 1], NULL);
-												DeleteList(&others, NULL);
-												others = intersection;
-												cub->d[1 - upperindex[i]][i + 1] = cubevecc[i];
-												intersection = Intersection(others, cubevecc[i]->s[1 - upperindex[i]][i + 1], NULL);
-												DeleteList(&others, NULL);
-												others = intersection;
-											}
-/*insert the cube if the boundary conditions are satisfied and there is no other cube with the same boundary*/
-											if (BdIdsOK(cub) && others == NULL) {												
-												for (i = 0; i < degree - 1; i++) 
-													((cube **) cub->edges->coord)[i] = ((cube **) cub->d[0][degree - 1]->edges->coord)[i];
-												((cube **) cub->edges->coord)[degree - 1] = ((cube **) cub->d[0][degree - 3]->edges->coord)[degree - 2];
-												top[0]->s[0][edgeindex] = InsertElement(cub, top[0]->s[0][edgeindex]);
-												top[1]->s[1][edgeindex] = InsertElement(cub, top[1]->s[1][edgeindex]);
-												for (i = 0; i < edgeindex; i++) {
-													faces[vc[i]]->s[upperindex[i]][i] = InsertElement(cub, faces[vc[i]]->s[upperindex[i]][i]);
-													cubevecc[i]->s[1 - upperindex[i]][i] = InsertElement(cub, cubevecc[i]->s[1 - upperindex[i]][i]);
-												}
-												for (i = edgeindex; i < degree - 1; i++) {
-													faces[vc[i]]->s[upperindex[i]][i + 1] = InsertElement(cub, faces[vc[i]]->s[upperindex[i]][i + 1]);
-													cubevecc[i]->s[1 - upperindex[i]][i + 1] = InsertElement(cub, cubevecc[i]->s[1 - upperindex[i]][i + 1]);
-												}																																
-												cubelist[degree] = InsertElement(cub, cubelist[degree]);
-												cub->cl = cubelist[degree]->prev;																				
-												newcount++;
-											}
-											else {
-												DeleteCube(cub);
-												DeleteList(&others, NULL);												
-											}
-											cveclist = cveclist->next;
-										} while (cveclist != cubeveclist);
-										DeleteList(&cubeveclist, DeleteVector);
-									}
-									tlist[1] = tlist[1]->next;
-								} while (tlist[1] != toplist[1]);
-								tlist[0] = tlist[0]->next;
-							} while (tlist[0] != toplist[0]);
-						}
-						DeleteList(&toplist[0], NULL);
-						DeleteList(&toplist[1], NULL);
-						ulist = ulist->next;
-					} while (ulist != upperindices);
-					DeleteList(&upperindices, DeleteVector);
-				}						
-				veclist = veclist->next;			
-			} while (veclist != config);
-			DeleteList(&config, DeleteVector);
-		}		
+	switch (degree) {
+		case 3:
+			return FillHDCubes3(edge, cubelist, index, degree, facecount);
+		case 4:
+			return FillHDCubes4(edge, cubelist, index, degree, facecount);
+		default:
+			return degree > 2 ? FillHDCubesN(edge, cubelist, index, degree, facecount) : 0;
 	}
-	DeleteVector(facevec);	
-	return newcount;
 } 
 
 
-/*Completes HDA cubelist at given edge, returns the dimension of the highest cube added, returns -1 if no cube is added*/ 
+/*Completes HDA cubelist at given edge and adds the new cubes to index, returns the dimension of the highest cube added, returns -1 if no cube is added*/ 
 
-int FillCubes(cube *edge, list *cubelist[]) {
+int FillCubes(cube *edge, array *cubelist[], cubeindex *index) {
 
 	int  facecount, dim = -1;
 
-	facecount = FillSquares(edge, cubelist);
+	facecount = maxdim == 0 || maxdim >= 2 ? FillSquares(edge, cubelist, index) : 0;
 	if (facecount > 0)
-		dim = 1;
-	while (facecount != 0) 
-		facecount = FillHDCubes(edge, cubelist, ++dim  + 1, facecount);	
+		dim = 2;
+	while (facecount != 0 && (maxdim == 0 || dim < maxdim)) {
+		facecount = FillHDCubes(edge, cubelist, index, dim + 1, facecount);	
+		if (facecount > 0)
+			dim++;
+	}
 	return dim;	
 }
+
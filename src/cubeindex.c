@@ -0,0 +1,141 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File cubeindex.c
+
+This file implements the functions declared in cubeindex.h.
+************************************************************************************************/
+
+#include "cubeindex.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "hashmap.h"
+#include "cube.h"
+
+
+/*Function prototypes*/
+
+static unsigned int Signature(const void *pc); /*Hash value of the boundary signature of the cube pc*/
+static int SameBoundary(const void *pc1, const void *pc2); /*Returns 1 if the cubes pc1 and pc2 of the same degree have the same boundary and 0 otherwise*/
+
+
+/*Function implementations*/
+
+/*Hash value of the boundary signature of the cube pc*/
+
+static unsigned int Signature(const void *pc) {
+
+	const cube *c = pc;
+	unsigned int i, h = 2166136261u;
+
+	for (i = 0; i < c->degree; i++) {
+		h = (h ^ c->d[0][i]->id) * 16777619u;
+		h = (h ^ c->d[1][i]->id) * 16777619u;
+	}
+	h ^= h >> 15;
+	h *= 0x2c1b3c6du;
+	h ^= h >> 12;
+	return h;
+}
+
+
+/*Returns 1 if the cubes pc1 and pc2 of the same degree have the same boundary and 0 otherwise*/
+
+static int SameBoundary(const void *pc1, const void *pc2) {
+
+	const cube *c1 = pc1, *c2 = pc2;
+	unsigned int i;
+
+	for (i = 0; i < c1->degree; i++) 
+		if (c1->d[0][i] != c2->d[0][i] || c1->d[1][i] != c2->d[1][i])
+			return 0;
+	return 1;
+}
+
+
+/*Creates new empty index for cubes of degree 1,..., dim*/
+
+cubeindex *NewCubeindex(unsigned int dim) {
+
+	cubeindex *ci;
+	unsigned int d;
+
+	if ((ci = malloc(sizeof(cubeindex))) == NULL || (ci->t = malloc(sizeof(hashmap *) * (dim > 0 ? dim : 1))) == NULL) {
+		printf("NewCubeindex: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	ci->dim = dim;
+	for (d = 0; d < dim; d++) 
+		ci->t[d] = NewCustomHashmap(Signature, SameBoundary);
+	return ci;
+}
+
+
+/*Deletes the given index (but not the cubes)*/
+
+void DeleteCubeindex(cubeindex *ci) {
+
+	unsigned int d;
+
+	if (ci) {
+		for (d = 0; d < ci->dim; d++) 
+			DeleteHashmap(ci->t[d], NULL);
+		free(ci->t);
+		free(ci);
+	}
+}
+
+
+/*Inserts pc (whose boundary must be complete) in the index*/
+
+void AddToCubeindex(cubeindex *ci, struct cube *pc) {
+
+/*a cube with the same boundary is not inserted*/
+	if (pc->degree > 0 && pc->degree <= ci->dim) 
+		AddToHashmap(ci->t[pc->degree - 1], pc, pc);
+}
+
+
+/*Returns a cube of degree d with boundaries d[0][i] == bd0[i] and d[1][i] == bd1[i] if there is one and NULL otherwise*/
+
+struct cube *FindCube(const cubeindex *ci, unsigned int d, struct cube *const bd0[], struct cube *const bd1[]) {
+
+	cube key;
+
+	if (d == 0 || d > ci->dim || ci->t[d - 1]->n == 0) 
+		return NULL;
+/*only the degree and the boundary of the key are used*/
+	key.degree = d;
+	key.d[0] = (cube **) bd0;
+	key.d[1] = (cube **) bd1;
+	return LookupKey(ci->t[d - 1], &key);
+}
+
+
+/*Returns an indexed cube with the same boundary as pc if there is one and NULL otherwise*/
+
+struct cube *LookupCube(const cubeindex *ci, const struct cube *pc) {
+
+	return FindCube(ci, pc->degree, pc->d[0], pc->d[1]);
+}
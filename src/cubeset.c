@@ -0,0 +1,287 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File cubeset.c
+
+This file implements the functions declared in cubeset.h. Intersections are computed by merging 
+the two arrays if their sizes are similar and by galloping through the larger array otherwise. 
+For long arrays, an SSE2 version of galloping is used if it is available.
+************************************************************************************************/
+
+#include "cubeset.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cube.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+#define GALLOP_RATIO 16	/*galloping is used if one set is GALLOP_RATIO times larger than the other*/ 
+#define SIMD_MIN 32	/*minimal size of the larger set for the use of SIMD instructions*/
+
+
+/*Function prototypes*/
+
+static unsigned int MergeKernel(const unsigned int *aid, struct cube *const *ael, unsigned int na, const unsigned int *bid, unsigned int nb, unsigned int *oid, struct cube **oel); /*Intersection by merging*/ 
+static unsigned int GallopKernel(const unsigned int *aid, struct cube *const *ael, unsigned int na, const unsigned int *bid, unsigned int nb, unsigned int *oid, struct cube **oel); /*Intersection by galloping through b*/ 
+#ifdef __SSE2__
+static unsigned int SIMDKernel(const unsigned int *aid, struct cube *const *ael, unsigned int na, const unsigned int *bid, unsigned int nb, unsigned int *oid, struct cube **oel); /*Intersection by scanning b in blocks of four elements*/
+#endif
+static unsigned int Intersect(const unsigned int *aid, struct cube *const *ael, unsigned int na, const unsigned int *bid, unsigned int nb, unsigned int *oid, struct cube **oel); /*Chooses an intersection kernel*/ 
+
+
+/*Function implementations*/
+
+/*Initializes s as an empty cube set*/
+
+void InitCubeset(cubeset *s) {
+
+	s->n = 0;
+	s->cap = CUBESET_INLINE;
+}
+
+
+/*Removes all elements from s and frees its memory*/
+
+void ClearCubeset(cubeset *s) {
+
+	if (s->cap > CUBESET_INLINE) {
+		free(s->heap.id);
+		free(s->heap.el);
+	}
+	InitCubeset(s);
+}
+
+
+/*Removes all elements from s but keeps its memory*/
+
+void EmptyCubeset(cubeset *s) {
+
+	s->n = 0;
+}
+
+
+/*Makes sure that s can hold cap elements*/
+
+void ReserveCubeset(cubeset *s, unsigned int cap) {
+
+	unsigned int *id;
+	struct cube **el;
+	
+	if (cap > s->cap) {
+		if (cap < 2 * s->cap)
+			cap = 2 * s->cap;
+		if ((id = malloc(sizeof(unsigned int) * cap)) == NULL || (el = malloc(sizeof(struct cube *) * cap)) == NULL) {
+			printf("ReserveCubeset: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		memcpy(id, CubesetIds(s), sizeof(unsigned int) * s->n);
+		memcpy(el, CubesetCubes(s), sizeof(struct cube *) * s->n);
+		if (s->cap > CUBESET_INLINE) {
+			free(s->heap.id);
+			free(s->heap.el);
+		}
+		s->heap.id = id;
+		s->heap.el = el;
+		s->cap = cap;
+	}
+}
+
+
+/*Inserts pc in s (if it is not yet an element)*/
+
+void AddToCubeset(cubeset *s, struct cube *pc) {
+
+	unsigned int i, *id;
+	struct cube **el;
+
+	ReserveCubeset(s, s->n + 1);
+	id = CubesetIds(s);
+	el = CubesetCubes(s);
+	i = s->n;
+	while (i > 0 && id[i - 1] > pc->id) /*cubes are usually inserted in the order of their numbers*/
+		i--;
+	if (i > 0 && id[i - 1] == pc->id) 
+		return;
+	memmove(id + i + 1, id + i, sizeof(unsigned int) * (s->n - i));
+	memmove(el + i + 1, el + i, sizeof(struct cube *) * (s->n - i));
+	id[i] = pc->id;
+	el[i] = pc;
+	s->n++;
+}
+
+
+/*Returns 1 if pc belongs to s and 0 otherwise*/
+
+int IsInCubeset(const struct cube *pc, const cubeset *s) {
+
+	const unsigned int *id = CubesetIds(s);
+	unsigned int lo = 0, hi = s->n, mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2;
+		if (id[mid] < pc->id)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo < s->n && id[lo] == pc->id;
+}
+
+
+/*Makes dst a copy of src*/
+
+void CopyCubeset(cubeset *dst, const cubeset *src) {
+
+	ReserveCubeset(dst, src->n);
+	memcpy(CubesetIds(dst), CubesetIds(src), sizeof(unsigned int) * src->n);
+	memcpy(CubesetCubes(dst), CubesetCubes(src), sizeof(struct cube *) * src->n);
+	dst->n = src->n;
+}
+
+
+/*Intersection by merging*/
+
+static unsigned int MergeKernel(const unsigned int *aid, struct cube *const *ael, unsigned int na, const unsigned int *bid, unsigned int nb, unsigned int *oid, struct cube **oel) {
+
+	unsigned int i = 0, j = 0, k = 0;
+
+	while (i < na && j < nb) {
+		if (aid[i] < bid[j])
+			i++;
+		else if (aid[i] > bid[j])
+			j++;
+		else {
+			oid[k] = aid[i];
+			oel[k++] = ael[i];
+			i++;
+			j++;
+		}
+	}
+	return k;
+}
+
+
+/*Intersection by galloping through b*/
+
+static unsigned int GallopKernel(const unsigned int *aid, struct cube *const *ael, unsigned int na, const unsigned int *bid, unsigned int nb, unsigned int *oid, struct cube **oel) {
+
+	unsigned int i, j = 0, k = 0, step, lo, hi, mid;
+
+	for (i = 0; i < na && j < nb; i++) {
+/*find a range [lo, hi) of b containing the first element >= aid[i]*/
+		lo = j;
+		step = 1;
+		while (j < nb && bid[j] < aid[i]) {
+			lo = j + 1;
+			j += step;
+			step *= 2;
+		}
+		hi = j < nb ? j + 1 : nb;
+		while (lo < hi) {
+			mid = lo + (hi - lo) / 2;
+			if (bid[mid] < aid[i])
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		j = lo;
+		if (j < nb && bid[j] == aid[i]) {
+			oid[k] = aid[i];
+			oel[k++] = ael[i];
+			j++;
+		}
+	}
+	return k;
+}
+
+
+#ifdef __SSE2__
+
+/*Intersection by scanning b in blocks of four elements*/
+
+static unsigned int SIMDKernel(const unsigned int *aid, struct cube *const *ael, unsigned int na, const unsigned int *bid, unsigned int nb, unsigned int *oid, struct cube **oel) {
+
+	unsigned int i = 0, j = 0, k = 0;
+	__m128i key, block;
+
+	while (i < na) {
+		while (j + 4 <= nb && bid[j + 3] < aid[i])
+			j += 4;
+		if (j + 4 > nb)
+			break;
+		key = _mm_set1_epi32((int) aid[i]);
+		block = _mm_loadu_si128((const __m128i *) (bid + j));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(key, block))) {
+			oid[k] = aid[i];
+			oel[k++] = ael[i];
+		}
+		i++;
+	}
+	return k + MergeKernel(aid + i, ael + i, na - i, bid + j, nb - j, oid + k, oel + k);
+}
+
+#endif
+
+
+/*Chooses an intersection kernel, a should be the smaller array, the output arrays may coincide with those of a or b*/ 
+
+static unsigned int Intersect(const unsigned int *aid, struct cube *const *ael, unsigned int na, const unsigned int *bid, unsigned int nb, unsigned int *oid, struct cube **oel) {
+
+	if (na == 0 || nb == 0 || aid[0] > bid[nb - 1] || bid[0] > aid[na - 1])
+		return 0;
+	if (nb >= GALLOP_RATIO * na) 
+		return GallopKernel(aid, ael, na, bid, nb, oid, oel);
+#ifdef __SSE2__
+	if (nb >= SIMD_MIN) 
+		return SIMDKernel(aid, ael, na, bid, nb, oid, oel);
+#endif
+	return MergeKernel(aid, ael, na, bid, nb, oid, oel);
+}
+
+
+/*Computes the intersection of s1 and s2 in dst, returns the number of its elements*/
+
+unsigned int IntersectCubesets(cubeset *dst, const cubeset *s1, const cubeset *s2) {
+
+	const cubeset *a = s1->n <= s2->n ? s1 : s2, *b = s1->n <= s2->n ? s2 : s1;
+
+	ReserveCubeset(dst, a->n);
+	dst->n = Intersect(CubesetIds(a), CubesetCubes(a), a->n, CubesetIds(b), b->n, CubesetIds(dst), CubesetCubes(dst));
+	return dst->n;
+}
+
+
+/*Replaces s by its intersection with t (without allocating memory), returns the number of remaining elements*/
+
+unsigned int RestrictCubeset(cubeset *s, const cubeset *t) {
+
+	if (s->n <= t->n)
+		s->n = Intersect(CubesetIds(s), CubesetCubes(s), s->n, CubesetIds(t), t->n, CubesetIds(s), CubesetCubes(s));
+	else
+		s->n = Intersect(CubesetIds(t), CubesetCubes(t), t->n, CubesetIds(s), s->n, CubesetIds(s), CubesetCubes(s));
+	return s->n;
+}
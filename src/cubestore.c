@@ -0,0 +1,545 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File cubestore.c
+
+This file implements the functions declared in cubestore.h. 
+************************************************************************************************/
+
+#include "cubestore.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include "vector.h"
+#include "array.h"
+#include "cube.h"
+
+
+/*Structures*/
+
+typedef struct facekey facekey;
+
+struct facekey {
+	const uint32_t *face;	/*new numbers of the faces of a cube in increasing order*/
+	int len;	/*number of faces*/
+	uint32_t id;	/*old number of the cube*/
+};
+
+
+/*Function prototypes*/
+
+static uint32_t *NewIds(size_t n); /*Allocates an array of n numbers which are set to 0*/
+static void DeleteLabelVector(vector *lab); /*Deletes the given label word and its labels*/
+static void BuildCofaces(cubestore *cs, int d); /*Builds the coface arrays of degree d - 1 from the boundaries of the cubes of degree d*/
+static int Facekeycmp(const void *k1, const void *k2); /*Compares face keys lexicographically, keys with equal faces are ordered by the old numbers of their cubes*/
+static uint32_t *VertexOrder(const cubestore *cs); /*Returns the new numbers of the vertices in breadth-first order of the 1-skeleton*/
+static uint32_t *CubeOrder(const cubestore *cs, int d, const uint32_t newlow[]); /*Returns the new numbers of the cubes of degree d >= 1 ordered by the new numbers of their faces*/
+static void PermuteLevel(storelevel *lev, int d, const uint32_t newid[], const uint32_t newlow[], const uint32_t newedge[]); /*Renumbers the cubes of degree d and their faces and edges*/
+static int ChainVertex(const cubestore *cs, uint32_t v); /*Returns 1 if vertex v is neither initial nor final and has exactly one incoming and one outgoing edge, none of which lies in a square, and 0 otherwise*/
+static uint32_t NextEdge(const cubestore *cs, const unsigned char chain[], uint32_t e, unsigned char seen[]); /*Returns the edge following edge e through a chain vertex and marks the vertex as seen, returns e if the target of e is not a chain vertex*/
+
+
+/*Function implementations*/
+
+/*Allocates an array of n numbers which are set to 0*/
+
+static uint32_t *NewIds(size_t n) {
+
+	uint32_t *ids;
+
+	if ((ids = calloc(n > 0 ? n : 1, sizeof(uint32_t))) == NULL) {
+		printf("NewIds: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	return ids;
+}
+
+
+/*Deletes the given label word and its labels*/
+
+static void DeleteLabelVector(vector *lab) {
+
+	int j;
+
+	if (lab) {
+		for (j = 0; j < lab->dim; j++) 
+			DeleteLabel(((label **) lab->coord)[j]);
+		DeleteVector(lab);
+	}
+}
+
+
+/*Builds the coface arrays of degree d - 1 from the boundaries of the cubes of degree d*/
+
+static void BuildCofaces(cubestore *cs, int d) {
+
+	const storelevel *lev = &cs->lev[d];
+	storelevel *low = &cs->lev[d - 1];
+	uint32_t i, f, *pos;
+	int j, k;
+
+	if ((pos = malloc(sizeof(uint32_t) * (low->n > 0 ? low->n : 1))) == NULL) {
+		printf("BuildCofaces: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	for (k = 0; k < 2; k++) {
+		free(low->cooff[k]);
+		low->cooff[k] = NewIds((size_t) low->n + 1);
+		for (i = 0; i < lev->n; i++) 
+			for (j = 0; j < d; j++) 
+				low->cooff[k][lev->bd[k][(size_t) i * d + j] + 1]++;
+		for (f = 0; f < low->n; f++) {
+			low->cooff[k][f + 1] += low->cooff[k][f];
+			pos[f] = low->cooff[k][f];
+		}
+		free(low->coid[k]);
+		low->coid[k] = NewIds(low->cooff[k][low->n]);
+		for (i = 0; i < lev->n; i++) 
+			for (j = 0; j < d; j++) 
+				low->coid[k][pos[lev->bd[k][(size_t) i * d + j]]++] = i;
+	}
+	free(pos);
+}
+
+
+/*Creates new empty store for an HDA of dimension dim*/
+
+cubestore *NewCubestore(int dim) {
+
+	cubestore *cs;
+	int d;
+
+	if ((cs = malloc(sizeof(cubestore))) == NULL || (cs->lev = malloc(sizeof(storelevel) * (dim + 1))) == NULL) {
+		printf("NewCubestore: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	cs->dim = dim;
+	for (d = 0; d <= dim; d++) {
+		cs->lev[d].n = 0;
+		cs->lev[d].bd[0] = cs->lev[d].bd[1] = NULL;
+		cs->lev[d].edges = NULL;
+		cs->lev[d].cooff[0] = cs->lev[d].cooff[1] = NULL;
+		cs->lev[d].coid[0] = cs->lev[d].coid[1] = NULL;
+		cs->lev[d].lab = NULL;
+		cs->lev[d].flags = NULL;
+	}
+	return cs;
+}
+
+
+/*Deletes the given store and the labels it contains*/
+
+void DeleteCubestore(cubestore *cs) {
+
+	int d, k;
+	uint32_t i;
+	storelevel *lev;
+
+	if (cs) {
+		for (d = 0; d <= cs->dim; d++) {
+			lev = &cs->lev[d];
+			for (k = 0; k < 2; k++) {
+				free(lev->bd[k]);
+				free(lev->cooff[k]);
+				free(lev->coid[k]);
+			}
+			free(lev->edges);
+			if (lev->lab) {
+				for (i = 0; i < lev->n; i++) 
+					DeleteLabelVector(lev->lab[i]);
+				free(lev->lab);
+			}
+			free(lev->flags);
+		}
+		free(cs->lev);
+		free(cs);
+	}
+}
+
+
+/*Stores the cubes of degree d in cubelist and builds the coface arrays of degree d - 1, takes over the labels of the cubes, the degrees have to be stored in increasing order*/
+
+void StoreDegree(cubestore *cs, const array *cubelist, int d) {
+
+	storelevel *lev = &cs->lev[d];
+	cube *pc;
+	uint32_t i;
+	int j, k;
+
+	lev->n = cubelist->n;
+	if (d > 0) {
+		lev->bd[0] = NewIds((size_t) lev->n * d);
+		lev->bd[1] = NewIds((size_t) lev->n * d);
+		lev->edges = NewIds((size_t) lev->n * d);
+	}
+	if (d <= 1 && (lev->lab = malloc(sizeof(vector *) * (lev->n > 0 ? lev->n : 1))) == NULL) {
+		printf("StoreDegree: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	if (d == 0 && (lev->flags = malloc(sizeof(flagfield) * (lev->n > 0 ? lev->n : 1))) == NULL) {
+		printf("StoreDegree: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	for (k = 0; k < 2; k++) {
+		lev->cooff[k] = NewIds((size_t) lev->n + 1);
+		lev->coid[k] = NewIds(0);
+	}
+	for (i = 0; i < lev->n; i++) {
+		pc = (cube *) cubelist->el[i];
+		for (j = 0; j < d; j++) {
+			lev->bd[0][(size_t) i * d + j] = pc->d[0][j]->id;
+			lev->bd[1][(size_t) i * d + j] = pc->d[1][j]->id;
+			lev->edges[(size_t) i * d + j] = ((cube **) pc->edges->coord)[j]->id;
+		}
+		if (lev->lab) {
+			lev->lab[i] = pc->lab;
+			pc->lab = NULL;
+		}
+		if (lev->flags) 
+			lev->flags[i] = pc->flags;
+	}
+	if (d > 0) 
+		BuildCofaces(cs, d);
+}
+
+
+/*Creates the store of HDA cubes of dimension dim*/
+
+cubestore *StoreHDA(array *const cubes[], int dim) {
+
+	cubestore *cs = NewCubestore(dim);
+	int d;
+
+	for (d = 0; d <= dim; d++) 
+		StoreDegree(cs, cubes[d], d);
+	return cs;
+}
+
+
+/*Compares face keys lexicographically, keys with equal faces are ordered by the old numbers of their cubes*/
+
+static int Facekeycmp(const void *k1, const void *k2) {
+
+	const facekey *fk1 = k1, *fk2 = k2;
+	int i;
+
+	for (i = 0; i < fk1->len; i++) 
+		if (fk1->face[i] != fk2->face[i]) 
+			return fk1->face[i] < fk2->face[i] ? -1 : 1;
+	return fk1->id < fk2->id ? -1 : fk1->id > fk2->id;
+}
+
+
+/*Returns the new numbers of the vertices in breadth-first order of the 1-skeleton*/
+
+static uint32_t *VertexOrder(const cubestore *cs) {
+
+	const storelevel *lev0 = &cs->lev[0], *lev1 = &cs->lev[1];
+	uint32_t *newid, *queue, head, tail = 0, r, v, w, e;
+	int pass, k;
+
+	newid = NewIds(lev0->n);
+	queue = NewIds(lev0->n);
+	for (v = 0; v < lev0->n; v++) 
+		newid[v] = lev0->n;
+	for (pass = 0; pass < 2; pass++) 	/*the initial vertices are the first roots*/
+		for (r = 0; r < lev0->n; r++) {
+			if (newid[r] < lev0->n || (pass == 0 && !lev0->flags[r].ini)) 
+				continue;
+			head = tail;
+			newid[r] = tail;
+			queue[tail++] = r;
+			while (head < tail) {
+				v = queue[head++];
+				for (k = 0; k < 2 && cs->dim > 0; k++) 
+					for (e = lev0->cooff[k][v]; e < lev0->cooff[k][v + 1]; e++) {
+						w = lev1->bd[1 - k][lev0->coid[k][e]];
+						if (newid[w] == lev0->n) {
+							newid[w] = tail;
+							queue[tail++] = w;
+						}
+					}
+			}
+		}
+	free(queue);
+	return newid;
+}
+
+
+/*Returns the new numbers of the cubes of degree d >= 1 ordered by the new numbers of their faces*/
+
+static uint32_t *CubeOrder(const cubestore *cs, int d, const uint32_t newlow[]) {
+
+	const storelevel *lev = &cs->lev[d];
+	uint32_t *newid, *faces, i, f;
+	facekey *keys;
+	int j, k, m;
+
+	newid = NewIds(lev->n);
+	faces = NewIds((size_t) lev->n * 2 * d);
+	if ((keys = malloc(sizeof(facekey) * (lev->n > 0 ? lev->n : 1))) == NULL) {
+		printf("CubeOrder: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < lev->n; i++) {
+		keys[i].face = &faces[(size_t) i * 2 * d];
+		keys[i].len = 2 * d;
+		keys[i].id = i;
+		for (k = 0; k < 2; k++) 	/*insertion sort of the 2d faces*/
+			for (j = 0; j < d; j++) {
+				f = newlow[lev->bd[k][(size_t) i * d + j]];
+				for (m = k * d + j; m > 0 && faces[(size_t) i * 2 * d + m - 1] > f; m--) 
+					faces[(size_t) i * 2 * d + m] = faces[(size_t) i * 2 * d + m - 1];
+				faces[(size_t) i * 2 * d + m] = f;
+			}
+	}
+	qsort(keys, lev->n, sizeof(facekey), Facekeycmp);
+	for (i = 0; i < lev->n; i++) 
+		newid[keys[i].id] = i;
+	free(keys);
+	free(faces);
+	return newid;
+}
+
+
+/*Renumbers the cubes of degree d and their faces and edges*/
+
+static void PermuteLevel(storelevel *lev, int d, const uint32_t newid[], const uint32_t newlow[], const uint32_t newedge[]) {
+
+	uint32_t i, *bd[2], *edges;
+	vector **lab;
+	flagfield *flags;
+	int j, k;
+
+	if (d > 0) {
+		for (k = 0; k < 2; k++) {
+			bd[k] = NewIds((size_t) lev->n * d);
+			for (i = 0; i < lev->n; i++) 
+				for (j = 0; j < d; j++) 
+					bd[k][(size_t) newid[i] * d + j] = newlow[lev->bd[k][(size_t) i * d + j]];
+			free(lev->bd[k]);
+			lev->bd[k] = bd[k];
+		}
+		edges = NewIds((size_t) lev->n * d);
+		for (i = 0; i < lev->n; i++) 
+			for (j = 0; j < d; j++) 
+				edges[(size_t) newid[i] * d + j] = newedge[lev->edges[(size_t) i * d + j]];
+		free(lev->edges);
+		lev->edges = edges;
+	}
+	if (lev->lab) {
+		if ((lab = malloc(sizeof(vector *) * (lev->n > 0 ? lev->n : 1))) == NULL) {
+			printf("PermuteLevel: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (i = 0; i < lev->n; i++) 
+			lab[newid[i]] = lev->lab[i];
+		free(lev->lab);
+		lev->lab = lab;
+	}
+	if (lev->flags) {
+		if ((flags = malloc(sizeof(flagfield) * (lev->n > 0 ? lev->n : 1))) == NULL) {
+			printf("PermuteLevel: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (i = 0; i < lev->n; i++) 
+			flags[newid[i]] = lev->flags[i];
+		free(lev->flags);
+		lev->flags = flags;
+	}
+}
+
+
+/*Renumbers the cubes for locality: the vertices in breadth-first order of the 1-skeleton starting at the initial vertex, the cubes of degree d >= 1 by the new numbers of their faces*/
+
+void ReorderCubestore(cubestore *cs) {
+
+	uint32_t **newid;
+	int d;
+
+	if ((newid = malloc(sizeof(uint32_t *) * (cs->dim + 1))) == NULL) {
+		printf("ReorderCubestore: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	newid[0] = VertexOrder(cs);
+	for (d = 1; d <= cs->dim; d++) 
+		newid[d] = CubeOrder(cs, d, newid[d - 1]);
+	for (d = 0; d <= cs->dim; d++) 
+		PermuteLevel(&cs->lev[d], d, newid[d], d > 0 ? newid[d - 1] : NULL, d > 0 ? newid[1] : NULL);
+	for (d = 1; d <= cs->dim; d++) 
+		BuildCofaces(cs, d);
+	for (d = 0; d <= cs->dim; d++) 
+		free(newid[d]);
+	free(newid);
+}
+
+
+/*Returns 1 if vertex v is neither initial nor final and has exactly one incoming and one outgoing edge, none of which lies in a square, and 0 otherwise*/
+
+static int ChainVertex(const cubestore *cs, uint32_t v) {
+
+	const storelevel *lev0 = &cs->lev[0], *lev1 = &cs->lev[1];
+	uint32_t e;
+	int k, l;
+
+	if (lev0->flags[v].ini || lev0->flags[v].fin || lev0->cooff[0][v + 1] - lev0->cooff[0][v] != 1 || lev0->cooff[1][v + 1] - lev0->cooff[1][v] != 1) 
+		return 0;
+	for (k = 0; k < 2; k++) {
+		e = lev0->coid[k][lev0->cooff[k][v]];
+		for (l = 0; l < 2; l++) 
+			if (lev1->cooff[l][e + 1] != lev1->cooff[l][e]) 
+				return 0;
+	}
+	return 1;
+}
+
+
+/*Returns the edge following edge e through a chain vertex and marks the vertex as seen, returns e if the target of e is not a chain vertex*/
+
+static uint32_t NextEdge(const cubestore *cs, const unsigned char chain[], uint32_t e, unsigned char seen[]) {
+
+	const storelevel *lev0 = &cs->lev[0];
+	uint32_t v = cs->lev[1].bd[1][e];
+
+	if (!chain[v]) 
+		return e;
+	seen[v] = 1;
+	return lev0->coid[0][lev0->cooff[0][v]];
+}
+
+
+/*Contracts the maximal chains of edges through chain vertices (see ChainVertex()) into single edges labelled by the concatenated label words, a cycle of chain vertices keeps its first vertex*/
+
+void ReduceCubestore(cubestore *cs) {
+
+	storelevel *lev0 = &cs->lev[0], *lev1 = &cs->lev[1], *lev;
+	unsigned char *chain, *seen;
+	uint32_t *newv, *newe, *bd[2], n0 = 0, n1 = 0, v, e, f, g, i;
+	vector **lab, *word;
+	flagfield *flags;
+	int d, j, len;
+
+	if (cs->dim < 1) 
+		return;
+	if ((chain = malloc(lev0->n + 1)) == NULL || (seen = calloc(lev0->n + 1, 1)) == NULL) {
+		printf("ReduceCubestore: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	for (v = 0; v < lev0->n; v++) 
+		chain[v] = ChainVertex(cs, v);
+	for (e = 0; e < lev1->n; e++) 	/*chain vertices reached from other vertices*/
+		if (!chain[lev1->bd[0][e]]) 
+			for (f = e; (g = NextEdge(cs, chain, f, seen)) != f; f = g);
+	for (v = 0; v < lev0->n; v++) 	/*cycles of chain vertices*/
+		if (chain[v] && !seen[v]) {
+			chain[v] = 0;
+			for (f = lev0->coid[0][lev0->cooff[0][v]]; (g = NextEdge(cs, chain, f, seen)) != f; f = g);
+		}
+/*new numbers of the remaining vertices and edges*/
+	newv = NewIds(lev0->n);
+	newe = NewIds(lev1->n);
+	for (v = 0; v < lev0->n; v++) 
+		newv[v] = chain[v] ? lev0->n : n0++;
+	for (e = 0; e < lev1->n; e++) 
+		newe[e] = chain[lev1->bd[0][e]] ? lev1->n : n1++;
+/*vertices*/
+	if ((flags = malloc(sizeof(flagfield) * (n0 > 0 ? n0 : 1))) == NULL || (lab = malloc(sizeof(vector *) * (n0 > 0 ? n0 : 1))) == NULL) {
+		printf("ReduceCubestore: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	for (v = 0; v < lev0->n; v++) 
+		if (chain[v]) 
+			DeleteLabelVector(lev0->lab[v]);
+		else {
+			flags[newv[v]] = lev0->flags[v];
+			lab[newv[v]] = lev0->lab[v];
+		}
+	free(lev0->flags);
+	free(lev0->lab);
+	lev0->flags = flags;
+	lev0->lab = lab;
+	lev0->n = n0;
+/*edges, the label words of a chain are concatenated*/
+	bd[0] = NewIds(n1);
+	bd[1] = NewIds(n1);
+	if ((lab = malloc(sizeof(vector *) * (n1 > 0 ? n1 : 1))) == NULL) {
+		printf("ReduceCubestore: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	for (e = 0; e < lev1->n; e++) 
+		if (newe[e] < lev1->n) {
+			len = 0;
+			f = e;
+			do {
+				len += lev1->lab[f]->dim;
+				g = f;
+			} while ((f = NextEdge(cs, chain, g, seen)) != g);
+			word = NewVector(len, sizeof(label *));
+			len = 0;
+			f = e;
+			do {
+				for (j = 0; j < lev1->lab[f]->dim; j++) 
+					((label **) word->coord)[len++] = ((label **) lev1->lab[f]->coord)[j];
+				DeleteVector(lev1->lab[f]);
+				lev1->lab[f] = NULL;
+				g = f;
+			} while ((f = NextEdge(cs, chain, g, seen)) != g);
+			bd[0][newe[e]] = newv[lev1->bd[0][e]];
+			bd[1][newe[e]] = newv[lev1->bd[1][g]];
+			lab[newe[e]] = word;
+		}
+	free(lev1->bd[0]);
+	free(lev1->bd[1]);
+	free(lev1->lab);
+	lev1->bd[0] = bd[0];
+	lev1->bd[1] = bd[1];
+	lev1->lab = lab;
+	lev1->n = n1;
+	for (e = 0; e < n1; e++) 
+		lev1->edges[e] = e;
+/*higher cubes, whose edges all remain*/
+	for (d = 2; d <= cs->dim; d++) {
+		lev = &cs->lev[d];
+		for (i = 0; i < (size_t) lev->n * d; i++) {
+			lev->edges[i] = newe[lev->edges[i]];
+			if (d == 2) {
+				lev->bd[0][i] = newe[lev->bd[0][i]];
+				lev->bd[1][i] = newe[lev->bd[1][i]];
+			}
+		}
+	}
+	BuildCofaces(cs, 1);
+	if (cs->dim >= 2) 
+		BuildCofaces(cs, 2);
+	else 
+		for (j = 0; j < 2; j++) {
+			free(lev1->cooff[j]);
+			free(lev1->coid[j]);
+			lev1->cooff[j] = NewIds((size_t) n1 + 1);
+			lev1->coid[j] = NewIds(0);
+		}
+	free(newv);
+	free(newe);
+	free(chain);
+	free(seen);
+}
@@ -0,0 +1,296 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File evaltable.c
+
+This file implements the functions declared in evaltable.h.
+************************************************************************************************/
+
+#include "evaltable.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "vector.h"
+#include "list.h"
+#include "array.h"
+#include "pgraph.h"
+
+
+/*Function prototypes*/
+
+static evaltable *NewEvaltable(const list *varlist, int n, const array *vars, int *const *args, int count); /*Creates an empty table for the first n variables of varlist, whose codes cover their domains and the evaluations args[0], ..., args[count - 1], returns NULL if a variable is not in vars or has an empty domain or if the codes do not fit in 64 bits*/
+static int Encode(const evaltable *tab, const int *vals, const int *slot, uint64_t *c); /*Computes the code c of the values vals[slot[i]] (or vals[i] if slot is NULL) of the variables, returns 0 if the values have no code and 1 otherwise*/
+static void Fill(evaltable *tab, int *const *args, int count, int rows); /*Enters the evaluations args[0], ..., args[count - 1] in the table, with their numbers if rows is not 0*/
+static int CodeCmp(const void *p, const void *q); /*Compares pairs of codes and evaluation numbers for qsort*/
+static int Search(const evaltable *tab, uint64_t c); /*Returns the position of code c among the sorted codes, -1 if it is not one of them*/
+
+
+/*Function implementations*/
+
+/*Creates an empty table for the first n variables of varlist, whose codes cover their domains and the evaluations args[0], ..., args[count - 1], returns NULL if a variable is not in vars or has an empty domain or if the codes do not fit in 64 bits*/
+
+static evaltable *NewEvaltable(const list *varlist, int n, const array *vars, int *const *args, int count) {
+
+	evaltable *tab;
+	const intvar *var;
+	const list *node = varlist;
+	const int *dom;
+	int i, j, max;
+	unsigned k;
+
+	if (n > 0 && !varlist)
+		return NULL;
+	if ((tab = malloc(sizeof(evaltable))) == NULL || (tab->slot = malloc(sizeof(int) * (n > 0 ? n : 1))) == NULL 
+		|| (tab->min = malloc(sizeof(int) * (n > 0 ? n : 1))) == NULL || (tab->radix = malloc(sizeof(uint64_t) * (n > 0 ? n : 1))) == NULL 
+		|| (tab->stride = malloc(sizeof(uint64_t) * (n > 0 ? n : 1))) == NULL) {
+		printf("NewEvaltable: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	tab->n = n;
+	tab->size = 1;
+	tab->bits = NULL;
+	tab->row = NULL;
+	tab->code = NULL;
+	tab->coderow = NULL;
+	tab->no_codes = 0;
+	for (i = 0; i < n; i++, node = node->next) {
+		var = (intvar *) node->data;
+/*variables are matched by name as in the evaluation of the first versions*/
+		for (k = 0; k < vars->n && strcmp(var->id, ((intvar *) vars->el[k])->id) != 0; k++)
+			;
+		if (k == vars->n || var->domain->dim == 0) {
+			DeleteEvaltable(tab);
+			return NULL;
+		}
+		tab->slot[i] = k;
+		dom = var->domain->coord;
+		tab->min[i] = max = dom[0];
+		for (j = 1; j < var->domain->dim; j++) {
+			tab->min[i] = dom[j] < tab->min[i] ? dom[j] : tab->min[i];
+			max = dom[j] > max ? dom[j] : max;
+		}
+		for (j = 0; j < count; j++) {
+			tab->min[i] = args[j][i] < tab->min[i] ? args[j][i] : tab->min[i];
+			max = args[j][i] > max ? args[j][i] : max;
+		}
+		tab->radix[i] = (uint64_t) ((int64_t) max - tab->min[i]) + 1;
+		tab->stride[i] = tab->size;
+		if (tab->size > UINT64_MAX / tab->radix[i]) {
+			DeleteEvaltable(tab);
+			return NULL;
+		}
+		tab->size *= tab->radix[i];
+	}
+	return tab;
+}
+
+
+/*Computes the code c of the values vals[slot[i]] (or vals[i] if slot is NULL) of the variables, returns 0 if the values have no code and 1 otherwise*/
+
+static int Encode(const evaltable *tab, const int *vals, const int *slot, uint64_t *c) {
+
+	int i;
+	uint64_t d;
+
+	*c = 0;
+	for (i = 0; i < tab->n; i++) {
+		d = (uint64_t) ((int64_t) vals[slot ? slot[i] : i] - tab->min[i]);
+		if (d >= tab->radix[i])
+			return 0;
+		*c += d * tab->stride[i];
+	}
+	return 1;
+}
+
+
+/*Enters the evaluations args[0], ..., args[count - 1] in the table, with their numbers if rows is not 0*/
+
+static void Fill(evaltable *tab, int *const *args, int count, int rows) {
+
+	uint64_t c, (*pair)[2];
+	int i, m;
+
+	if (tab->size <= EVALTABLE_MAXDIRECT || tab->size / 64 <= (uint64_t) count) {
+		if (rows) {
+			if ((tab->row = malloc(sizeof(int) * tab->size)) == NULL) {
+				printf("Fill: Out of memory!\n");
+				exit(EXIT_FAILURE);
+			}
+			for (c = 0; c < tab->size; c++)
+				tab->row[c] = -1;
+		}
+		else if ((tab->bits = calloc((tab->size + 63) / 64, sizeof(uint64_t))) == NULL) {
+			printf("Fill: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (i = 0; i < count; i++) {
+			Encode(tab, args[i], NULL, &c);
+			if (!rows)
+				tab->bits[c >> 6] |= (uint64_t) 1 << (c & 63);
+			else if (tab->row[c] < 0)
+				tab->row[c] = i;
+		}
+		return;
+	}
+/*sort the pairs (code, number) and keep the first number of every code*/
+	if ((pair = malloc(sizeof(uint64_t[2]) * (count > 0 ? count : 1))) == NULL || (tab->code = malloc(sizeof(uint64_t) * (count > 0 ? count : 1))) == NULL 
+		|| (rows && (tab->coderow = malloc(sizeof(int) * (count > 0 ? count : 1))) == NULL)) {
+		printf("Fill: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < count; i++) {
+		Encode(tab, args[i], NULL, &pair[i][0]);
+		pair[i][1] = i;
+	}
+	qsort(pair, count, sizeof(uint64_t[2]), CodeCmp);
+	for (i = m = 0; i < count; i++) {
+		if (m > 0 && tab->code[m - 1] == pair[i][0])
+			continue;
+		tab->code[m] = pair[i][0];
+		if (rows)
+			tab->coderow[m] = (int) pair[i][1];
+		m++;
+	}
+	tab->no_codes = m;
+	free(pair);
+}
+
+
+/*Compares pairs of codes and evaluation numbers for qsort*/
+
+static int CodeCmp(const void *p, const void *q) {
+
+	const uint64_t *a = p, *b = q;
+
+	if (a[0] != b[0])
+		return a[0] < b[0] ? -1 : 1;
+	return a[1] < b[1] ? -1 : a[1] > b[1];
+}
+
+
+/*Returns the position of code c among the sorted codes, -1 if it is not one of them*/
+
+static int Search(const evaltable *tab, uint64_t c) {
+
+	int lo = 0, hi = tab->no_codes - 1, mid;
+
+	while (lo <= hi) {
+		mid = lo + (hi - lo) / 2;
+		if (tab->code[mid] == c)
+			return mid;
+		if (tab->code[mid] < c)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+	return -1;
+}
+
+
+/*Creates the table of the evaluations of the condition, returns NULL if a variable of the condition is not in vars or has an empty domain*/
+
+evaltable *TabulateCondition(const condition *cond, const array *vars) {
+
+	evaltable *tab;
+	int i, count = NumberOfElements(cond->evallist), **args;
+	const list *node = cond->evallist;
+
+	if ((args = malloc(sizeof(int *) * (count > 0 ? count : 1))) == NULL) {
+		printf("TabulateCondition: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < count; i++, node = node->next) {
+		if (((vector *) node->data)->dim < cond->no_vars) {
+			free(args);
+			return NULL;
+		}
+		args[i] = ((vector *) node->data)->coord;
+	}
+	if ((tab = NewEvaltable(cond->varlist, cond->no_vars, vars, args, count)))
+		Fill(tab, args, count, 0);
+	free(args);
+	return tab;
+}
+
+
+/*Creates the table of the evaluations for which the effect of the action is defined, returns NULL if a variable of the action is not in vars or has an empty domain*/
+
+evaltable *TabulateAction(const action *act, const array *vars) {
+
+	evaltable *tab;
+
+	if ((tab = NewEvaltable(act->varlist, act->no_vars, vars, act->map[0], act->no_evals)))
+		Fill(tab, act->map[0], act->no_evals, 1);
+	return tab;
+}
+
+
+/*Deletes given table*/
+
+void DeleteEvaltable(void *tab) {
+
+	evaltable *t = tab;
+
+	if (t) {
+		free(t->slot);
+		free(t->min);
+		free(t->radix);
+		free(t->stride);
+		free(t->bits);
+		free(t->row);
+		free(t->code);
+		free(t->coderow);
+		free(t);
+	}
+}
+
+
+/*Returns 1 if the values of the variables of the table in the valuation vals form one of its evaluations and 0 otherwise*/
+
+int ContainsEvaluation(const evaltable *tab, const int *vals) {
+
+	uint64_t c;
+
+	if (!Encode(tab, vals, tab->slot, &c))
+		return 0;
+	if (tab->bits)
+		return (tab->bits[c >> 6] >> (c & 63)) & 1;
+	return Search(tab, c) >= 0;
+}
+
+
+/*Returns the number of the first evaluation of the action whose arguments are the values of the variables of the table in the valuation vals, -1 if there is none*/
+
+int FindEvaluation(const evaltable *tab, const int *vals) {
+
+	uint64_t c;
+	int i;
+
+	if (!Encode(tab, vals, tab->slot, &c))
+		return -1;
+	if (tab->row)
+		return tab->row[c];
+	return (i = Search(tab, c)) >= 0 ? tab->coderow[i] : -1;
+}
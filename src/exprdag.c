@@ -0,0 +1,187 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File exprdag.c
+
+This file implements the functions declared in exprdag.h.
+************************************************************************************************/
+
+#include "exprdag.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "def.h"
+#include "vector.h"
+#include "array.h"
+#include "hashmap.h"
+#include "pgraph.h"
+
+
+#define EXPRDAG_MINSIZE 64	/*initial number of allocated nodes*/
+
+
+/*Function prototypes*/
+
+static int AddNode(exprdag *dag, int op, int a, int b, int create); /*Returns the index of the node (op, a, b), which is created if it does not exist yet and create is 1, returns -1 if it does not exist and create is 0*/
+static int Enter(exprdag *dag, const ast *exp, const array *vars, int create); /*Returns the index of the node of the expression, whose nodes are created if they do not exist yet and create is 1, returns -1 if the expression is NULL, contains a variable not in vars or (create being 0) is not in the DAG*/
+
+
+/*Function implementations*/
+
+/*Returns the index of the node (op, a, b), which is created if it does not exist yet and create is 1, returns -1 if it does not exist and create is 0*/
+
+static int AddNode(exprdag *dag, int op, int a, int b, int create) {
+
+	int keycoord[3] = {op, a, b};
+	vector key = {3, keycoord}, *newkey;
+	void *i;
+
+	if ((i = LookupKey(dag->index, &key)))
+		return (int) (uintptr_t) i - 1;
+	if (!create)
+		return -1;
+	if (dag->n == dag->size) {
+		dag->size *= 2;
+		if ((dag->node = realloc(dag->node, sizeof(dagnode) * dag->size)) == NULL || (dag->mark = realloc(dag->mark, sizeof(unsigned int) * dag->size)) == NULL 
+			|| (dag->val = realloc(dag->val, sizeof(int) * dag->size)) == NULL) {
+			printf("AddNode: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	dag->node[dag->n].op = op;
+	dag->node[dag->n].a = a;
+	dag->node[dag->n].b = b;
+	dag->node[dag->n].refs = 0;
+	dag->mark[dag->n] = 0;
+/*numbers and variables are operands, not nodes*/
+	if (op != DAG_NUM && op != DAG_VAR) {
+		if (a >= 0)
+			dag->node[a].refs++;
+		if (b >= 0)
+			dag->node[b].refs++;
+	}
+	newkey = NewVector(3, sizeof(int));
+	((int *) newkey->coord)[0] = op;
+	((int *) newkey->coord)[1] = a;
+	((int *) newkey->coord)[2] = b;
+	AddToHashmap(dag->index, newkey, (void *) (uintptr_t) (dag->n + 1));
+	return dag->n++;
+}
+
+
+/*Returns the index of the node of the expression, whose nodes are created if they do not exist yet and create is 1, returns -1 if the expression is NULL, contains a variable not in vars or (create being 0) is not in the DAG*/
+
+static int Enter(exprdag *dag, const ast *exp, const array *vars, int create) {
+
+	int a = -1, b;
+	unsigned i;
+
+	if (!exp)
+		return -1;
+	switch (exp->type) {
+		case NUM:
+			return AddNode(dag, DAG_NUM, exp->node.num, -1, create);
+		case VAR:
+			for (i = 0; vars && i < vars->n; i++)
+				if (vars->el[i] == exp->node.var)
+					return AddNode(dag, DAG_VAR, i, -1, create);
+			return -1;
+		default:
+/*as in Evaluate, the left operand of ! and of the unary minus is ignored*/
+			if (exp->node.op < PLUS || exp->node.op > NOT)
+				return -1;
+			if (exp->node.op != NOT && exp->l && (a = Enter(dag, exp->l, vars, create)) < 0)
+				return -1;
+			if ((b = Enter(dag, exp->r, vars, create)) < 0 || (a < 0 && exp->node.op != NOT && exp->node.op != MINUS))
+				return -1;
+			return AddNode(dag, exp->node.op, a, b, create);
+	}
+}
+
+
+/*Creates new empty expression DAG*/
+
+exprdag *NewExprdag() {
+
+	exprdag *dag;
+
+	if ((dag = malloc(sizeof(exprdag))) == NULL || (dag->node = malloc(sizeof(dagnode) * EXPRDAG_MINSIZE)) == NULL 
+		|| (dag->mark = malloc(sizeof(unsigned int) * EXPRDAG_MINSIZE)) == NULL || (dag->val = malloc(sizeof(int) * EXPRDAG_MINSIZE)) == NULL) {
+		printf("NewExprdag: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	dag->n = 0;
+	dag->size = EXPRDAG_MINSIZE;
+	dag->index = NewHashmap(INT);
+	dag->stamp = 1;
+	return dag;
+}
+
+
+/*Deletes given expression DAG*/
+
+void DeleteExprdag(exprdag *dag) {
+
+	if (dag) {
+		DeleteHashmap(dag->index, DeleteVector);
+		free(dag->node);
+		free(dag->mark);
+		free(dag->val);
+		free(dag);
+	}
+}
+
+
+/*Adds the expression over the variables in vars to the DAG, returns the index of its node or -1 if the expression is NULL or contains a variable not in vars*/
+
+int AddToExprdag(exprdag *dag, const ast *exp, const array *vars) {
+
+	int i = Enter(dag, exp, vars, 1);
+
+	if (i >= 0)
+		dag->node[i].refs++;
+	return i;
+}
+
+
+/*Returns the index of the node of the expression over the variables in vars, -1 if it is not in the DAG*/
+
+int FindInExprdag(const exprdag *dag, const ast *exp, const array *vars) {
+
+	return Enter((exprdag *) dag, exp, vars, 0);
+}
+
+
+/*Discards the cached values, must be called when the values of the variables change*/
+
+void ForgetValues(exprdag *dag) {
+
+	int i;
+
+	if (++dag->stamp == 0) {
+		for (i = 0; i < dag->n; i++)
+			dag->mark[i] = 0;
+		dag->stamp = 1;
+	}
+}
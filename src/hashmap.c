@@ -0,0 +1,227 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File hashmap.c
+
+This file implements the functions declared in hashmap.h. The maps use open addressing with 
+linear probing and are kept at most half full. 
+************************************************************************************************/
+
+#include "hashmap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "def.h"
+#include "vector.h"
+
+
+#define HASHMAP_MINSIZE 64	/*initial number of slots of a map*/
+
+
+/*Function prototypes*/
+
+static unsigned int Mix(uint64_t h); /*Final mixing of a 64-bit hash state into a hash value*/
+static unsigned int HashKey(const hashmap *hm, const void *key); /*Hash value of a key of hm*/
+static int SameKey(const hashmap *hm, const void *key1, const void *key2); /*Returns 1 if the keys of hm are equal and 0 otherwise*/
+static unsigned int FindSlot(const hashmap *hm, const void *key, unsigned int h); /*Returns the slot of the key with hash value h in hm, or the empty slot where it would be inserted*/
+static void InitMap(hashmap *hm, unsigned int size); /*Initializes hm as an empty map with size slots*/
+static void GrowMap(hashmap *hm); /*Doubles the number of slots of hm*/
+
+
+/*Function implementations*/
+
+/*Final mixing of a 64-bit hash state into a hash value*/
+
+static unsigned int Mix(uint64_t h) {
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdu;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53u;
+	h ^= h >> 33;
+	return (unsigned int) h;
+}
+
+
+/*Hash value of a key of hm*/
+
+static unsigned int HashKey(const hashmap *hm, const void *key) {
+
+	if (hm->hashfn) 
+		return hm->hashfn(key);
+	if (hm->type == INT) 
+		return IntVecHash(key);
+	return Mix((uintptr_t) key);
+}
+
+
+/*Returns 1 if the keys of hm are equal and 0 otherwise*/
+
+static int SameKey(const hashmap *hm, const void *key1, const void *key2) {
+
+	if (hm->samefn) 
+		return hm->samefn(key1, key2);
+	if (hm->type == INT) 
+		return IntVecEqual(key1, key2);
+	return key1 == key2;
+}
+
+
+/*Returns the slot of the key with hash value h in hm, or the empty slot where it would be inserted*/
+
+static unsigned int FindSlot(const hashmap *hm, const void *key, unsigned int h) {
+
+	unsigned int j;
+
+	for (j = h & (hm->size - 1); hm->key[j]; j = (j + 1) & (hm->size - 1))
+		if (hm->hash[j] == h && SameKey(hm, hm->key[j], key))
+			break;
+	return j;
+}
+
+
+/*Initializes hm as an empty map with size slots*/
+
+static void InitMap(hashmap *hm, unsigned int size) {
+
+	if ((hm->key = calloc(size, sizeof(void *))) == NULL || (hm->val = malloc(sizeof(void *) * size)) == NULL 
+		|| (hm->hash = malloc(sizeof(unsigned int) * size)) == NULL) {
+		printf("InitMap: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	hm->size = size;
+	hm->n = 0;
+}
+
+
+/*Doubles the number of slots of hm*/
+
+static void GrowMap(hashmap *hm) {
+
+	hashmap old = *hm;
+	unsigned int i, j;
+
+	InitMap(hm, 2 * old.size);
+	for (i = 0; i < old.size; i++) {
+		if (old.key[i]) {
+			for (j = old.hash[i] & (hm->size - 1); hm->key[j]; j = (j + 1) & (hm->size - 1))
+				;
+			hm->key[j] = old.key[i];
+			hm->val[j] = old.val[i];
+			hm->hash[j] = old.hash[i];
+		}
+	}
+	hm->n = old.n;
+	free(old.key);
+	free(old.val);
+	free(old.hash);
+}
+
+
+/*Creates new empty hash map for keys of the given type*/
+
+hashmap *NewHashmap(int type) {
+
+	hashmap *hm;
+
+	if ((hm = malloc(sizeof(hashmap))) == NULL) {
+		printf("NewHashmap: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	hm->type = type;
+	hm->hashfn = NULL;
+	hm->samefn = NULL;
+	InitMap(hm, HASHMAP_MINSIZE);
+	return hm;
+}
+
+
+/*Creates new empty hash map for keys hashed by hashfn and compared by samefn*/
+
+hashmap *NewCustomHashmap(unsigned int (*hashfn)(const void *key), int (*samefn)(const void *key1, const void *key2)) {
+
+	hashmap *hm = NewHashmap(PTR);
+
+	hm->hashfn = hashfn;
+	hm->samefn = samefn;
+	return hm;
+}
+
+
+/*Deletes the given hash map and, unless delkey is NULL, its keys by means of delkey (but not the values)*/
+
+void DeleteHashmap(hashmap *hm, void (*delkey)(void *)) {
+
+	unsigned int i;
+
+	if (hm) {
+		if (delkey) 
+			for (i = 0; i < hm->size; i++) 
+				if (hm->key[i])
+					delkey(hm->key[i]);
+		free(hm->key);
+		free(hm->val);
+		free(hm->hash);
+		free(hm);
+	}
+}
+
+
+/*Inserts the key (which must not be NULL) with value val and returns 1 if hm does not yet contain the key, returns 0 and leaves hm unchanged otherwise*/
+
+int AddToHashmap(hashmap *hm, void *key, void *val) {
+
+	unsigned int h = HashKey(hm, key), j;
+
+	j = FindSlot(hm, key, h);
+	if (hm->key[j])
+		return 0;
+	if (2 * (hm->n + 1) > hm->size) {
+		GrowMap(hm);
+		j = FindSlot(hm, key, h);
+	}
+	hm->key[j] = key;
+	hm->val[j] = val;
+	hm->hash[j] = h;
+	hm->n++;
+	return 1;
+}
+
+
+/*Returns the value of the key in hm, NULL if hm does not contain the key*/
+
+void *LookupKey(const hashmap *hm, const void *key) {
+
+	unsigned int j = FindSlot(hm, key, HashKey(hm, key));
+
+	return hm->key[j] ? hm->val[j] : NULL;
+}
+
+
+/*Returns 1 if hm contains the key and 0 otherwise*/
+
+int IsKey(const hashmap *hm, const void *key) {
+
+	return hm->key[FindSlot(hm, key, HashKey(hm, key))] != NULL;
+}
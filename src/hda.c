@@ -30,21 +30,49 @@ This file implements the functions declared in hda.h.
 #include "hda.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h> 
 #include "def.h"
 #include "vector.h"
 #include "list.h"
+#include "array.h"
 #include "pgraph.h"
 #include "cube.h"
+#include "cubeset.h"
+#include "cubeindex.h"
+#include "levels.h"
+#include "hashmap.h"
+#include "mdd.h"
+#include "exprdag.h"
+
+
+/*Initial valuations (--old): the values of variable p are encoded by the digits of level p of an MDD, and every valuation in the intersection of the initial conditions is recorded with its position in the enumeration of the first versions, which is the tuple of the first numbers of the evaluations of the conditions that it extends, followed by the first positions of the values of the variables occurring in no condition in their domains*/
+
+typedef struct initvals initvals;
+
+struct initvals {
+	int conds, varcount;	/*numbers of conditions and variables*/
+	const int *no_vars;	/*no_vars[i] is the number of variables of condition i*/
+	const int *const *pos;	/*pos[i][j] is the position in the list of all variables of variable j of condition i*/
+	const int *const *value;	/*value[p][d] is the value of variable p with digit d*/
+	const int *const *firstdom;	/*firstdom[p][d] is the first position of the value with digit d in the domain of variable p if p occurs in no condition, NULL otherwise*/
+	hashmap *const *first;	/*first[i] maps the evaluations of condition i to their first numbers plus 1*/
+	int *ev;	/*space for an evaluation of any condition*/
+	array *rec;	/*records: INT vectors of the position (conds + varcount coordinates) followed by the valuation (varcount coordinates)*/
+};
 
 
 /*Function prototypes*/
 
-static list *InitialStates(const vector *pgvec, const list *varlist); /*Computes the initial global states of the system of program graphs in pgvec*/
-static int IsFinal(const state *st, const vector *pgvec, const list *varlist); /*Returns 1 if the state is a final state and 0 otherwise*/
-static int CubesOfStates(const list *statelist, list *cubelist[]); /*Produces cubes associated with states, returns the number of cubes*/
-static state *NextState(const state *sta, const transition *trans, int pid, const list *varlist); /*Computes the state after the given transition*/
-static int HandleState(const state *sta, list **statelist, list *cubelist[], const list *varlist); /*Computes edges and states incident with given state and adds all possible higher-dimensional cubes, returns the dimension of the highest-dimensional cube added, returns -1 if no cube is added*/
+static int IntCmp(const void *p, const void *q); /*Compares integers for qsort*/
+static int RecordCmp(const void *p, const void *q); /*Compares the records of initial valuations (pointers to INT vectors) lexicographically for qsort*/
+static int RecordInitial(const int digit[], void *data); /*Records the initial valuation with the given digits, returns 1*/
+static array *InitialValuations(const vector *pgvec, const array *vars); /*Computes the records of the initial valuations (--old) in the order of the first versions*/
+static int IsFinal(const state *st, const vector *pgvec, const array *vars); /*Returns 1 if the state is a final state and 0 otherwise*/
+static vector *StateKey(const state *st, vector *key); /*Stores the location indexes and the values of the variables of the state in the INT vector key, whose dimension must be the number of locations plus the number of values, returns key*/
+static int CubesOfStates(const array *statelist, array *cubelist[], hashmap *states); /*Produces cubes associated with states and enters them in the state map, returns the number of cubes*/
+static state *NextState(const state *sta, const transition *trans, int pid, const array *vars, exprdag *dag); /*Computes the state after the given transition*/
+static int HandleState(const state *sta, array *statelist, array *cubelist[], cubeindex *index, hashmap *states, const array *vars, exprdag *dag); /*Computes edges and states incident with given state and adds all possible higher-dimensional cubes, returns the dimension of the highest-dimensional cube added, returns -1 if no cube is added*/
 
 
 /*Function implementations*/
@@ -81,83 +109,246 @@ void DeleteState(void *st) {
 } 
 
 
+/*Compares integers for qsort*/
+
+static int IntCmp(const void *p, const void *q) {
+
+	const int a = *(const int *) p, b = *(const int *) q;
+
+	return (a > b) - (a < b);
+}
+
+
+/*Compares the records of initial valuations (pointers to INT vectors) lexicographically for qsort*/
+
+static int RecordCmp(const void *p, const void *q) {
+
+	const vector *a = *(vector *const *) p, *b = *(vector *const *) q;
+	int i;
+
+	for (i = 0; i < a->dim; i++) {
+		if (((int *) a->coord)[i] != ((int *) b->coord)[i])
+			return ((int *) a->coord)[i] < ((int *) b->coord)[i] ? -1 : 1;
+	}
+	return 0;
+}
+
+
+/*Records the initial valuation with the given digits, returns 1*/
+
+static int RecordInitial(const int digit[], void *data) {
+
+	initvals *iv = data;
+	vector *rec = NewVector(iv->conds + 2 * iv->varcount, sizeof(int)), ev;
+	int *r = rec->coord, *val = &r[iv->conds + iv->varcount], i, j, p;
+
+	for (p = 0; p < iv->varcount; p++) {
+		val[p] = iv->value[p][digit[p]];
+		r[iv->conds + p] = iv->firstdom[p] ? iv->firstdom[p][digit[p]] : 0;
+	}
+	for (i = 0; i < iv->conds; i++) {
+		for (j = 0; j < iv->no_vars[i]; j++)
+			iv->ev[j] = val[iv->pos[i][j]];
+		ev.dim = iv->no_vars[i];
+		ev.coord = iv->ev;
+		r[i] = (int) (uintptr_t) LookupKey(iv->first[i], &ev) - 1;
+	}
+	AppendToArray(iv->rec, rec);
+	return 1;
+}
+
+
+/*Computes the records of the initial valuations (--old) in the order of the first versions*/
+
+static array *InitialValuations(const vector *pgvec, const array *vars) {
+
+	const programgraph *const *const pg = pgvec->coord;
+	const int conds = pgvec->dim, varcount = vars->n, nv = varcount > 0 ? varcount : 1;
+	int i, j, k, c, p, d, r, set, valid, root, cnt, maxvars = 1, *colpos, **row;
+	int *pos[conds], no_vars[conds], n[conds], owner[nv], *value[nv], radix[nv], *firstdom[nv];
+	const int *dom, *e;
+	const list *node;
+	vector **eff[conds];
+	hashmap *first[conds];
+	initvals iv = {conds, varcount, no_vars, (const int *const *) pos, (const int *const *) value, (const int *const *) firstdom, first, NULL, NewArray()};
+	mdd *m;
+
+/*the evaluations are restricted to the distinct variables of the conditions: the condition that contains a variable first sets it by its last occurrence, the occurrences in the other conditions must agree*/
+	for (p = 0; p < varcount; p++)
+		owner[p] = -1;
+	for (i = 0; i < conds; i++) {
+		k = pg[i]->cond_0->no_vars;
+		n[i] = NumberOfElements(pg[i]->cond_0->evallist);
+		no_vars[i] = 0;
+		if ((colpos = malloc(sizeof(int) * (k > 0 ? k : 1))) == NULL || (pos[i] = malloc(sizeof(int) * (k > 0 ? k : 1))) == NULL 
+			|| (eff[i] = malloc(sizeof(vector *) * (n[i] > 0 ? n[i] : 1))) == NULL) {
+			printf("InitialValuations: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (c = 0, node = pg[i]->cond_0->varlist; c < k; c++, node = node->next) {
+			for (p = 0; strcmp(((intvar *) node->data)->id, ((intvar *) vars->el[p])->id) != 0; p++)
+				;
+			colpos[c] = p;
+			for (d = 0; d < c && colpos[d] != p; d++)
+				;
+			if (d == c)
+				pos[i][no_vars[i]++] = p;
+		}
+		for (d = 0; d < no_vars[i]; d++)
+			owner[pos[i][d]] = owner[pos[i][d]] < 0 ? i : owner[pos[i][d]];
+		maxvars = no_vars[i] > maxvars ? no_vars[i] : maxvars;
+		first[i] = NewHashmap(INT);
+		for (j = 0, node = pg[i]->cond_0->evallist; j < n[i]; j++, node = node->next) {
+			e = ((vector *) node->data)->coord;
+			eff[i][j] = NewVector(no_vars[i], sizeof(int));
+			for (d = 0, valid = 1; d < no_vars[i]; d++) {
+				for (c = 0, set = 0; c < k; c++) {
+					if (colpos[c] == pos[i][d]) {
+						if (set && owner[pos[i][d]] != i && ((int *) eff[i][j]->coord)[d] != e[c])
+							valid = 0;
+						((int *) eff[i][j]->coord)[d] = e[c];
+						set = 1;
+					}
+				}
+			}
+			if (!valid) {
+				DeleteVector(eff[i][j]);
+				eff[i][j] = NULL;
+			}
+			else
+				AddToHashmap(first[i], eff[i][j], (void *) (uintptr_t) (j + 1));
+		}
+		free(colpos);
+	}
+/*the digits of variable p number the distinct values of its domain and of the evaluations of the conditions in increasing order*/
+	for (p = 0; p < varcount; p++) {
+		dom = ((intvar *) vars->el[p])->domain->coord;
+		cnt = ((intvar *) vars->el[p])->domain->dim;
+		for (i = 0; i < conds; i++)
+			for (d = 0; d < no_vars[i]; d++)
+				cnt += pos[i][d] == p ? n[i] : 0;
+		if ((value[p] = malloc(sizeof(int) * (cnt > 0 ? cnt : 1))) == NULL) {
+			printf("InitialValuations: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (k = 0; k < ((intvar *) vars->el[p])->domain->dim; k++)
+			value[p][k] = dom[k];
+		for (i = 0; i < conds; i++)
+			for (d = 0; d < no_vars[i]; d++)
+				if (pos[i][d] == p)
+					for (j = 0; j < n[i]; j++)
+						if (eff[i][j])
+							value[p][k++] = ((int *) eff[i][j]->coord)[d];
+		qsort(value[p], k, sizeof(int), IntCmp);
+		for (c = d = 0; c < k; c++)
+			if (d == 0 || value[p][c] != value[p][d - 1])
+				value[p][d++] = value[p][c];
+		radix[p] = d;
+		firstdom[p] = NULL;
+		if (owner[p] < 0) {
+			if ((firstdom[p] = malloc(sizeof(int) * (d > 0 ? d : 1))) == NULL) {
+				printf("InitialValuations: Out of memory!\n");
+				exit(EXIT_FAILURE);
+			}
+			for (k = ((intvar *) vars->el[p])->domain->dim - 1; k >= 0; k--)
+				firstdom[p][(int *) bsearch(&dom[k], value[p], d, sizeof(int), IntCmp) - value[p]] = k;
+		}
+	}
+/*intersection of the initial conditions*/
+	m = NewMdd(varcount, radix);
+	root = MDD_TRUE;
+	for (i = 0; i < conds && root != MDD_FALSE; i++) {
+		if ((row = malloc(sizeof(int *) * (n[i] > 0 ? n[i] : 1))) == NULL) {
+			printf("InitialValuations: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (j = r = 0; j < n[i]; j++) {
+			if (!eff[i][j])
+				continue;
+			if ((row[r] = malloc(sizeof(int) * (no_vars[i] > 0 ? no_vars[i] : 1))) == NULL) {
+				printf("InitialValuations: Out of memory!\n");
+				exit(EXIT_FAILURE);
+			}
+			for (d = 0; d < no_vars[i]; d++)
+				row[r][d] = (int *) bsearch(&((int *) eff[i][j]->coord)[d], value[pos[i][d]], radix[pos[i][d]], sizeof(int), IntCmp) - value[pos[i][d]];
+			r++;
+		}
+		root = MddAnd(m, root, MddFromRows(m, pos[i], no_vars[i], row, r));
+		for (j = 0; j < r; j++)
+			free(row[j]);
+		free(row);
+	}
+	if ((iv.ev = malloc(sizeof(int) * maxvars)) == NULL) {
+		printf("InitialValuations: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	MddEnumerate(m, root, RecordInitial, &iv);
+	SortArray(iv.rec, RecordCmp);
+	DeleteMdd(m);
+	free(iv.ev);
+	for (i = 0; i < conds; i++) {
+		for (j = 0; j < n[i]; j++)
+			DeleteVector(eff[i][j]);
+		free(eff[i]);
+		free(pos[i]);
+		DeleteHashmap(first[i], NULL);
+	}
+	for (p = 0; p < varcount; p++) {
+		free(value[p]);
+		free(firstdom[p]);
+	}
+	return iv.rec;
+}
+
+
 /*Computes the initial global states of the system of program graphs in pgvec*/
 
-static list *InitialStates(const vector *pgvec, const list *varlist) {
+array *InitialStates(const vector *pgvec, const array *vars) {
 
-	condition *cond, *merge, *initialcond;
 	const programgraph *const *const pg = pgvec->coord;
 	int i, *valvar;
-	const list *vlist, *node;
-	vector *vec;
-	list *dejavulist = NULL, *statelist = NULL;
+	unsigned q;
+	array *statelist = NewArray(), *recs;
+	const vector *rec;
 	state *st;	
-	const int varcount = NumberOfElements(varlist);
+	const int varcount = vars->n;
 	char s[STRL*(pgvec->dim + varcount)], str[STRL];
-	intvar *var;
 	
 	if (inp == OPTION_old) {
-		initialcond = NewCondition();
-		if (pgvec->dim == 1)
-			cond = pg[0]->cond_0;
-		else {
-			cond = MergeConditions(pg[0]->cond_0, pg[1]->cond_0);		
-			for (i = 2; i < pgvec->dim && cond->evallist; i++) {
-				merge = MergeConditions(cond, pg[i]->cond_0);
-				DeleteCondition(cond);
-				cond = merge;			
+		recs = InitialValuations(pgvec, vars);
+		for (q = 0; q < recs->n; q++) {
+			rec = recs->el[q];
+			st = NewState(pgvec->dim, varcount);	
+			for (i = 0; i < pgvec->dim; i++) 
+				((location **) st->locvec->coord)[i] = pg[i]->loc_0;	
+			valvar = st->valvec->coord;		
+			for (i = 0; i < varcount; i++) 
+				valvar[i] = ((int *) rec->coord)[rec->dim - varcount + i];			
+			strcpy(s, "(");
+			for (i = 0; i < pgvec->dim; i++) {
+				sprintf(str, "%d,", pg[i]->loc_0->index);
+				strcat(s, str);
 			}
-		}	
-		if (cond->evallist) {
-			ExtendCondition(cond, initialcond, varlist);	
-			vlist = initialcond->evallist;
-			do {
-				vec = (vector *) vlist->data;
-				if (!IsElement(vec, dejavulist, Veccmp)) {				
-					dejavulist = InsertElement(vec, dejavulist);
-					st = NewState(pgvec->dim, varcount);	
-					for (i = 0; i < pgvec->dim; i++) 
-						((location **) st->locvec->coord)[i] = pg[i]->loc_0;	
-					valvar = st->valvec->coord;		
-					for (i = 0; i < varcount; i++) 
-						valvar[i] = ((int *) vec->coord)[i];			
-					strcpy(s, "(");
-					for (i = 0; i < pgvec->dim; i++) {
-						sprintf(str, "%d,", pg[i]->loc_0->index);
-						strcat(s, str);
-					}
-					for (i = 0; i < varcount - 1; i++) {
-						sprintf(str, "%d,", valvar[i]);
-						strcat(s, str);
-					}
-					sprintf(str, "%d)", valvar[varcount - 1]);
-					strcat(s, str);
-					st->cube->lab = NewVector(1, sizeof(label *));
-					((label **) st->cube->lab->coord)[0] = NewLabel(s, -1);
-					st->cube->flags.ini = 1;
-					statelist = InsertElement(st, statelist);
-				}
-				vlist = vlist->next;
-			} while (vlist != initialcond->evallist);
+			for (i = 0; i < varcount - 1; i++) {
+				sprintf(str, "%d,", valvar[i]);
+				strcat(s, str);
+			}
+			sprintf(str, "%d)", valvar[varcount - 1]);
+			strcat(s, str);
+			st->cube->lab = NewVector(1, sizeof(label *));
+			((label **) st->cube->lab->coord)[0] = NewLabel(s, -1);
+			st->cube->flags.ini = 1;
+			AppendToArray(statelist, st);
 		}
-		DeleteList(&dejavulist, NULL);	
-		if (pgvec->dim > 1)
-			DeleteCondition(cond);
-		DeleteCondition(initialcond);						
+		DeleteArray(recs, DeleteVector);
 	}
 	else {
 		st = NewState(pgvec->dim, varcount);	
 		for (i = 0; i < pgvec->dim; i++) 
 			((location **) st->locvec->coord)[i] = pg[i]->loc_0;	
 		valvar = (int *) st->valvec->coord;
-		node = varlist;
-		i = 0;
-		do {
-			var = (intvar *) node->data;
-			valvar[i] = var->initialval;
-			i++;
-			node = node->next;
-		} while (node != varlist);							
+		for (i = 0; i < varcount; i++)
+			valvar[i] = ((intvar *) vars->el[i])->initialval;
 		strcpy(s, "(");
 		for (i = 0; i < pgvec->dim; i++) {
 			sprintf(str, "%d,", pg[i]->loc_0->index);
@@ -172,7 +363,7 @@ static list *InitialStates(const vector *pgvec, const list *varlist) {
 		st->cube->lab = NewVector(1, sizeof(label *));
 		((label **) st->cube->lab->coord)[0] = NewLabel(s, -1);
 		st->cube->flags.ini = 1;
-		statelist = InsertElement(st, statelist);		
+		AppendToArray(statelist, st);
 	}	
 	return statelist;
 } 
@@ -180,7 +371,7 @@ static list *InitialStates(const vector *pgvec, const list *varlist) {
 
 /*Returns 1 if the state is a final state and 0 otherwise*/
 
-static int IsFinal(const state *st, const vector *pgvec, const list *varlist) {
+static int IsFinal(const state *st, const vector *pgvec, const array *vars) {
 
 	int i, isfinal = 1;
 	const programgraph *const *const pg = pgvec->coord;
@@ -190,50 +381,60 @@ static int IsFinal(const state *st, const vector *pgvec, const list *varlist) {
 			isfinal = 0;
 	}
 	for (i = 0; i < pgvec->dim && isfinal; i++) 
-		isfinal = CheckCondition(st->valvec, pg[i]->cond_1, varlist);
+		isfinal = CheckCondition(st->valvec, pg[i]->cond_1, vars, NULL);
 	return isfinal; 
 }
 
 
-/*Produces cubes associated with states, returns the number of cubes*/
+/*Stores the location indexes and the values of the variables of the state in the INT vector key, whose dimension must be the number of locations plus the number of values, returns key*/
+
+static vector *StateKey(const state *st, vector *key) {
+
+	int *k = key->coord, i;
+
+	for (i = 0; i < st->locvec->dim; i++)
+		k[i] = ((location **) st->locvec->coord)[i]->index;
+	memcpy(&k[st->locvec->dim], st->valvec->coord, sizeof(int) * st->valvec->dim);
+	return key;
+}
+
+
+/*Produces cubes associated with states and enters them in the state map, returns the number of cubes*/
 
-static int CubesOfStates(const list *statelist, list *cubelist[]) {
+static int CubesOfStates(const array *statelist, array *cubelist[], hashmap *states) {
 
-	const list *slist;
 	const state *st;
-	int n = 0;
-
-	if (statelist) {
-		slist = statelist;
-		do {
-			st = (state *) slist->data;
-			cubelist[0] = InsertElement(st->cube, cubelist[0]);
-			st->cube->cl = cubelist[0]->prev;	
-			n++;
-			slist = slist->next;
-		} while (slist != statelist);
+	unsigned i;
+
+	for (i = 0; i < statelist->n; i++) {
+		st = (state *) statelist->el[i];
+		InsertCube(st->cube, cubelist);	
+		AddToHashmap(states, StateKey(st, NewVector(st->locvec->dim + st->valvec->dim, sizeof(int))), st->cube);
 	}
-	return n; 
+	return statelist->n; 
 }
 
 
 /*Computes the state after the given transition*/
 
-static state *NextState(const state *sta, const transition *trans, int pid, const list *varlist) {
+static state *NextState(const state *sta, const transition *trans, int pid, const array *vars, exprdag *dag) {
 
 	state *st = NULL;
-	const int pgs = sta->locvec->dim, *val, varcount = NumberOfElements(varlist);	
+	const int pgs = sta->locvec->dim, *val, varcount = sta->valvec->dim;	
 	const location **loc;
 	int i;
 	char s[STRL*(pgs + varcount)], str[STRL];
 
-	if (CheckCondition(sta->valvec, trans->cond, varlist) == 1) {				
-		st = NewState(pgs, NumberOfElements(varlist));
+	if ((trans->guard ? trans->guard(sta->valvec->coord) : CheckCondition(sta->valvec, trans->cond, vars, dag)) == 1) {				
+		st = NewState(pgs, varcount);
 		loc = st->locvec->coord; 
 		for (i = 0; i < pgs; i++)
 			loc[i] = ((location **) sta->locvec->coord)[i];
 		loc[pid] = trans->loc[1];		
-		Effect(trans->act, sta->valvec, st->valvec, varlist);
+		if (trans->effect)
+			trans->effect(sta->valvec->coord, st->valvec->coord);
+		else
+			Effect(trans->act, sta->valvec, st->valvec, vars, dag);
 		strcpy(s, "(");
 		for (i = 0; i < pgs; i++) {
 			sprintf(str, "%d,", loc[i]->index);
@@ -255,35 +456,36 @@ static state *NextState(const state *sta, const transition *trans, int pid, cons
 
 /*Computes edges and states incident with given state and adds all possible higher-dimensional cubes, returns the dimension of the highest-dimensional cube added, returns -1 if no cube is added*/
 
-static int HandleState(const state *sta, list **statelist, list *cubelist[], const list *varlist) {
+static int HandleState(const state *sta, array *statelist, array *cubelist[], cubeindex *index, hashmap *states, const array *vars, exprdag *dag) {
 		
-	int i, isnew, dim = -1, d;	
+	int i, isnew, dim = -1, d, keycoord[sta->locvec->dim + sta->valvec->dim];	
 	const location **loc = sta->locvec->coord;
-	const list *tlist, *clist;
+	const list *tlist;
 	const transition *trans;
 	state *st;
 	cube *cpc, *pc;	
+	vector key = {sta->locvec->dim + sta->valvec->dim, keycoord};
 
+/*the values cached in the expression DAG belong to the previous state*/
+	if (dag)
+		ForgetValues(dag);
 	for (i = 0; i < sta->locvec->dim; i++) {		
 		if (loc[i]->outtranslist) {				
 			tlist = loc[i]->outtranslist; 
 			do {
 				trans = (transition *) tlist->data;															
-				if ((st = NextState(sta, trans, i, varlist))) {							    
+				if ((st = NextState(sta, trans, i, vars, dag))) {							    
 /*check whether state is new*/
-					isnew = 1;											
-					if (cubelist[0]) {					
-						clist = cubelist[0];						
-						do {						
-							cpc = (cube *) clist->data;							
-							if (VecCmp(cpc->lab, st->cube->lab, PTR, Labcmp) == 0) {							
-								isnew = 0;
-								DeleteCube(st->cube);
-								st->cube = cpc;
-								break;
-							}
-							clist = clist->next;
-						} while (clist != cubelist[0]);
+					isnew = (cpc = LookupKey(states, StateKey(st, &key))) == NULL;											
+/*if state is new, insert state and its cube, which must be numbered before the edge is indexed*/
+					if (isnew) {
+						AppendToArray(statelist, st);						
+						InsertCube(st->cube, cubelist);
+						AddToHashmap(states, StateKey(st, NewVector(key.dim, sizeof(int))), st->cube);																		
+					}				
+					else {					
+						DeleteCube(st->cube);
+						st->cube = cpc;
 					}										
 /*create edge for the transition*/
 					pc = NewCube(1);										
@@ -292,21 +494,18 @@ static int HandleState(const state *sta, list **statelist, list *cubelist[], con
 					((cube **) pc->edges->coord)[0] = pc;
 					pc->lab = NewVector(1, sizeof(label *));
 					((label **) pc->lab->coord)[0] = NewLabel(trans->act->id, i);					
-					cubelist[1] = InsertElement(pc, cubelist[1]);
-					pc->cl = cubelist[1]->prev;					
-					sta->cube->s[0][0] = InsertElement(pc, sta->cube->s[0][0]);
-					st->cube->s[1][0] = InsertElement(pc, st->cube->s[1][0]);									
+					InsertCube(pc, cubelist);
+					AddToCubeindex(index, pc);					
+					AddToCubeset(&sta->cube->s[0][0], pc);
+					AddToCubeset(&st->cube->s[1][0], pc);									
 					dim = 1 > dim ? 1 : dim;												
-/*if state is new, insert state and its cube, otherwise fill cubes at new edge*/
-					if (isnew) {
-						*statelist = InsertElement(st, *statelist);						
-						cubelist[0] = InsertElement(st->cube, cubelist[0]);
-						st->cube->cl = cubelist[0]->prev;																		
-					}				
-					else {							
+/*if state is not new, fill cubes at new edge*/
+					if (!isnew) {							
 						DeleteState(st);
-						d = FillCubes(pc, cubelist);
-						dim = d > dim ? d : dim;
+						if (build != OPTION_batch) {
+							d = FillCubes(pc, cubelist, index);
+							dim = d > dim ? d : dim;
+						}
 					}					
 				}			
 				tlist = tlist->next;
@@ -317,23 +516,31 @@ static int HandleState(const state *sta, list **statelist, list *cubelist[], con
 } 
 
 
-/*Transforms system of program graphs (pgvec) over the variables in varlist into HDA cubelist, returns the dimension of the HDA*/
+/*Transforms system of program graphs (pgvec) over the variables in vars into HDA cubelist, whose cubes are added to index, guards and assignments entered in dag (if not NULL) are evaluated once per state, returns the dimension of the HDA*/
 
-int MakeHDA(const vector *pgvec, list *cubelist[], const list *varlist) {
+int MakeHDA(const vector *pgvec, array *cubelist[], cubeindex *index, const array *vars, exprdag *dag) {
 	
-	list *queue = NULL; 
+	array *queue; 
 	const state *sta;
 	int d, dim = 0;		
-
-	queue = InitialStates(pgvec, varlist);			
-	CubesOfStates(queue, cubelist);	
-	while (queue) {	
-		sta = (state *) queue->data;
-		if (IsFinal(sta, pgvec, varlist))
+	unsigned q;
+	hashmap *states = NewHashmap(INT);	/*maps the keys of the states computed so far to their cubes*/
+
+	queue = InitialStates(pgvec, vars);			
+	CubesOfStates(queue, cubelist, states);	
+	for (q = 0; q < queue->n; q++) {	
+		sta = (state *) queue->el[q];
+		if (IsFinal(sta, pgvec, vars))
 			sta->cube->flags.fin = 1; 								
-		d = HandleState(sta, &queue, cubelist, varlist);										
+		d = HandleState(sta, queue, cubelist, index, states, vars, dag);										
+		dim = (d > dim) ? d : dim;
+		DeleteState(queue->el[q]);
+	}
+	DeleteArray(queue, NULL);
+	DeleteHashmap(states, DeleteVector);
+	if (build == OPTION_batch) {
+		d = FillLevels(cubelist, index, maxdim > 0 && maxdim < pgvec->dim ? maxdim : pgvec->dim, threads);
 		dim = (d > dim) ? d : dim;
-		Pop(&queue, DeleteState);
 	}
 	return dim;	
 }
@@ -37,6 +37,7 @@ This file implements the functions declared in io.h.
 #include "list.h"
 #include "pgraph.h"
 #include "cube.h"
+#include "cubestore.h"
 
 
 #define LINELENGTH 1000 /*maximal length of a line in an input file*/
@@ -55,8 +56,8 @@ static void PrintAst(const ast *exp); /*Prints expression*/
 static void PrintCondition(const condition *cond); /*Prints condition*/
 static void PrintTransitions(const list *translist); /*Prints transitions*/
 static void PrintPG(const programgraph *pg); /*Prints program graph*/
-static void PrintDegree(const list *cubelist, int d); /*Prints cubes of degree d*/ 
-static void PrintSageLabel(const cube *pc); /*Prints label of pc for use in Sage*/
+static void PrintDegree(const cubestore *cs, int d); /*Prints cubes of degree d*/ 
+static void PrintSageLabel(const cubestore *cs, int d, uint32_t n); /*Prints label of cube n of degree d for use in Sage*/
 
 
 /*Function implementations*/
@@ -612,6 +613,10 @@ void PrintPG(const programgraph *pg) {
 		else 
 			printf("\n%i transitions\n\n", pg->no_trans);
 		PrintTransitions(pg->translist);
+		if (pg->no_deadtrans > 0 || pg->no_deadlocs > 0) 
+			printf("\nremoved transitions (guard never satisfied or start location unreachable):\t%i\nremoved locations (unreachable):\t%i\n", pg->no_deadtrans, pg->no_deadlocs);
+		if (minimize == OPTION_minimize) 
+			printf("\nmerged locations (bisimilar):\t%i\nremoved transitions (merged):\t%i\n", pg->no_mergedlocs, pg->no_mergedtrans);
 		printf("\ninitial location:");
 		if (pg->loc_0)
 			printf("\t%i", pg->loc_0->index);
@@ -632,61 +637,60 @@ void PrintPG(const programgraph *pg) {
 
 /*Prints cubes of degree d*/
 
-static void PrintDegree(const list *cubelist, int d) {
+static void PrintDegree(const cubestore *cs, int d) {
 
-	const list *cubesd; 
-	int elcount = 0, j, i;
-	cube *pc; 
-	cube **edge;
+	const storelevel *lev = &cs->lev[d];
+	const uint32_t *edge;
+	const vector *lab;
+	uint32_t n;
+	int j, i;
 			
-	if ((cubesd = cubelist)) {			
-		do {
-			pc = (cube *) cubesd->data;				
-			printf("cube %i.%i: ", d, ++elcount);
-			if (d == 0) {
-				printf("%s", ((label **) pc->lab->coord)[0]->str);
-				if (pc->flags.ini == 1)
-					printf("  initial");
-				if (pc->flags.fin == 1)
-					printf("  final");
-				else if (!pc->s[0][0]) 
-					printf("  deadlock");								
-				printf("\n\n");
+	for (n = 0; n < lev->n; n++) {
+		printf("cube %i.%u: ", d, n + 1);
+		if (d == 0) {
+			printf("%s", ((label **) lev->lab[n]->coord)[0]->str);
+			if (lev->flags[n].ini == 1)
+				printf("  initial");
+			if (lev->flags[n].fin == 1)
+				printf("  final");
+			else if (lev->cooff[0][n + 1] == lev->cooff[0][n]) 
+				printf("  deadlock");								
+			printf("\n\n");
+		}
+		else {
+			edge = &lev->edges[(size_t) n * d];
+			printf("%s  ", ((label **) cs->lev[0].lab[cs->lev[1].bd[0][edge[0]]]->coord)[0]->str);
+			printf("(");				
+			lab = cs->lev[1].lab[edge[0]];
+			printf("%s", ((label **) lab->coord)[0]->str);
+			for (j = 1; j < lab->dim; j++) {
+				printf(";");
+				printf("%s", ((label **) lab->coord)[j]->str);
 			}
-			else {
-				edge = pc->edges->coord;
-				printf("%s  ", ((label **) edge[0]->d[0][0]->lab->coord)[0]->str);
-				printf("(");				
-				printf("%s", ((label **) edge[0]->lab->coord)[0]->str);
-				for (j = 1; j < edge[0]->lab->dim; j++) {
+			for (i = 1; i < d; i++) {
+				lab = cs->lev[1].lab[edge[i]];
+				printf(",  ");
+				printf("%s", ((label **) lab->coord)[0]->str);
+				for (j = 1; j < lab->dim; j++) {
 					printf(";");
-					printf("%s", ((label **) edge[0]->lab->coord)[j]->str);
+					printf("%s", ((label **) lab->coord)[j]->str);
 				}
-				for (i = 1; i < d; i++) {
-					printf(",  ");
-					printf("%s", ((label **) edge[i]->lab->coord)[0]->str);
-					for (j = 1; j < edge[i]->lab->dim; j++) {
-						printf(";");
-						printf("%s", ((label **) edge[i]->lab->coord)[j]->str);
-					}
-				}
-				printf(")\n\n");
-			}									
-			cubesd = cubesd->next;
-		} while (cubesd != cubelist);				
+			}
+			printf(")\n\n");
+		}									
 	}		
 }
 
 
-/*Prints the system and its HDA model*/
+/*Prints the system and its HDA model, truncated is 1 if cubes of higher degree have not been computed (--max-dim)*/
 
-void PrintSystemHDA(const vector* pgvec, const list *varlist, list *const cubes[], int dim) {
+void PrintSystemHDA(const vector* pgvec, const list *varlist, const cubestore *cs, int truncated) {
 
-	const int novars = NumberOfElements(varlist);
+	const int novars = NumberOfElements(varlist), dim = cs->dim;
 	int i, rk[dim + 1], sum = 0, bd = 0, deadlocks = 0, euler = 0;	
 	const programgraph *const *const pg = pgvec->coord;
-	const list *node;
-	const cube *pc;
+	const storelevel *lev0 = &cs->lev[0];
+	uint32_t n;
 		
 	if (out != OPTION_i) {
 		if (pgvec->dim > 1) 
@@ -713,11 +717,13 @@ void PrintSystemHDA(const vector* pgvec, const list *varlist, list *const cubes[
 	}		
 	if (out != OPTION_i) {		
 		for (i = 0; i <= dim; i++) {
-			rk[i] = NumberOfElements(cubes[i]);
+			rk[i] = cs->lev[i].n;
 			sum = sum + rk[i];
 			bd = bd + 2 * i * rk[i];  
 		}
 		printf("\nHDA model of dimension %i with %i elements and %i boundaries\n\n", dim, sum, bd);
+		if (truncated)
+			printf("%i-skeleton of the HDA model, cubes of higher degree have not been computed (--max-dim)\n\n", maxdim);
 		if (out != OPTION_s) 
 			printf("\n\n");
 		if (rk[0] == 1) 
@@ -726,7 +732,7 @@ void PrintSystemHDA(const vector* pgvec, const list *varlist, list *const cubes[
 			printf("Degree 0: %i elements\n", rk[0]);
 		if (out != OPTION_s) {
 			printf("\n\n");
-			PrintDegree(cubes[0], 0);
+			PrintDegree(cs, 0);
 			printf("\n");
 		}
 		for (i = 1; i <= dim; i++) {
@@ -736,20 +742,15 @@ void PrintSystemHDA(const vector* pgvec, const list *varlist, list *const cubes[
 				printf("Degree %i: %i elements (%i boundaries)\n", i, rk[i], 2 * i * rk[i]); 
 			if (out != OPTION_s) {
 				printf("\n\n");
-				PrintDegree(cubes[i], i);
+				PrintDegree(cs, i);
 				printf("\n");
 			}
 		}							
 		if (out != OPTION_s)
 			printf("\n\n");
-		if ((node = cubes[0])) {
-			do {
-				pc = (cube *) node->data;
-				if (!pc->flags.fin && !pc->s[0][0])
-					deadlocks++;
-				node = node->next;
-			} while (node != cubes[0]);
-		}	
+		for (n = 0; n < lev0->n; n++) 
+			if (!lev0->flags[n].fin && lev0->cooff[0][n + 1] == lev0->cooff[0][n])
+				deadlocks++;
 		if (deadlocks == 1)
 			printf("\n1 deadlock\n\n");
 		else 
@@ -763,28 +764,31 @@ void PrintSystemHDA(const vector* pgvec, const list *varlist, list *const cubes[
 }
 
 
-/*Computes label of pc for use in Sage*/
+/*Computes label of cube n of degree d for use in Sage*/
 
-static void PrintSageLabel(const cube *pc){
+static void PrintSageLabel(const cubestore *cs, int d, uint32_t n){
 
 	int i, j;
-	const cube **edge;
+	const uint32_t *edge;
+	const vector *lab;
 
-	if (pc->degree == 0) 
+	if (d == 0) 
 		printf("1");		
 	else {
-		edge = pc->edges->coord;						
-		printf("(%s", ((label **) edge[0]->lab->coord)[0]->str);
-		for (j = 1; j < edge[0]->lab->dim; j++) {
+		edge = &cs->lev[d].edges[(size_t) n * d];
+		lab = cs->lev[1].lab[edge[0]];
+		printf("(%s", ((label **) lab->coord)[0]->str);
+		for (j = 1; j < lab->dim; j++) {
 			printf("+");
-			printf("%s", ((label **) edge[0]->lab->coord)[j]->str);
+			printf("%s", ((label **) lab->coord)[j]->str);
 		}
-		for (i = 1; i < pc->degree; i++) {
+		for (i = 1; i < d; i++) {
+			lab = cs->lev[1].lab[edge[i]];
 			printf(")");
-			printf("*(%s", ((label **) edge[i]->lab->coord)[0]->str);
-			for (j = 1; j < edge[i]->lab->dim; j++) {
+			printf("*(%s", ((label **) lab->coord)[0]->str);
+			for (j = 1; j < lab->dim; j++) {
 				printf("+");
-				printf("%s", ((label **) edge[i]->lab->coord)[j]->str);
+				printf("%s", ((label **) lab->coord)[j]->str);
 			}
 		}
 		printf(")");
@@ -793,150 +797,107 @@ static void PrintSageLabel(const cube *pc){
 }
 
 
-/*Prints chain complex of HDA in Z_2 chomp format*/
+/*Prints chain complex of HDA in Z_2 chomp format, truncated is 1 if cubes of higher degree have not been computed*/
 
-void PrintChainComplex(list *const cubes[], int dim) {
+void PrintChainComplex(const cubestore *cs, int truncated) {
 
-	int d, i, rk[dim + 1];	
-	list *cubesd;	
-	cube *pc;
+	const int dim = cs->dim;
+	int d, i, k;	
+	const storelevel *lev;
+	uint32_t n, f;
 	
-	for (d = 0; d <= dim; d++) {			
-		i = 0;				
-		if ((cubesd = cubes[d])) {
-			do {
-				pc = (cube *) cubesd->data;				
-				pc->furtherdata = NewInt(++i);
-				cubesd = cubesd->next;
-			} while (cubesd != cubes[d]);
-		}
-		rk[d] = i;		
-	}
+	if (truncated)
+		printf("; %i-skeleton of the HDA model, cubes of higher degree have not been computed (--max-dim)\n\n", maxdim);
 	printf("chain complex\n\n");
 	printf("max dimension = %i\n\n", dim);
 	for (d = 0; d <= dim; d++) {
-		printf("dimension %i: %i\n\n", d, rk[d]);	
-		if ((cubesd = cubes[d])){
-			do {
-				pc = (cube *) cubesd->data;
-				printf("boundary %i.%i:", d, *(int *) pc->furtherdata);	
-				PrintSageLabel(pc);
-				printf(" = ");
+		lev = &cs->lev[d];
+		printf("dimension %i: %u\n\n", d, lev->n);	
+		for (n = 0; n < lev->n; n++) {
+			printf("boundary %i.%u:", d, n + 1);	
+			PrintSageLabel(cs, d, n);
+			printf(" = ");
+			for (k = 0; k < 2; k++) 
 				for (i = 0; i < d; i++) {
-					printf("+ %i.%i:", d - 1, *(int *) pc->d[0][i]->furtherdata);
-					PrintSageLabel(pc->d[0][i]);
+					f = lev->bd[k][(size_t) n * d + i];
+					printf("+ %i.%u:", d - 1, f + 1);
+					PrintSageLabel(cs, d - 1, f);
 					printf(" ");
 				}
-				for (i = 0; i < d; i++) {
-					printf("+ %i.%i:", d - 1, *(int *) pc->d[1][i]->furtherdata);
-					PrintSageLabel(pc->d[1][i]);
-					printf(" ");
-				}				
-				printf("\n");
-				cubesd = cubesd->next;
-			} while (cubesd != cubes[d]);
+			printf("\n");
 		}
 		printf("\n");
 	}	
-	for (d = 0; d <= dim; d++) {						
-		if ((cubesd = cubes[d])) {
-			do {
-				pc = (cube *) cubesd->data;				
-				DeleteInt(pc->furtherdata);
-				pc->furtherdata = NULL;
-				cubesd = cubesd->next;
-			} while (cubesd != cubes[d]);
-		}		
-	}
 }
 
 
-/*Prints HDA in tsv format*/
+/*Prints HDA in tsv format, truncated is 1 if cubes of higher degree have not been computed*/
 
-void PrintHDA(list *const cubes[], int dim) {
+void PrintHDA(const cubestore *cs, int truncated) {
 
-	int i, d, j;	
-	list *cubesd;	
-	cube *pc, **edge;
+	const int dim = cs->dim;
+	int i, d, j, k;	
+	const storelevel *lev;
+	const uint32_t *edge;
+	const vector *lab;
+	uint32_t n;
 	
+/*the note is not part of the table*/
+	if (truncated)
+		fprintf(stderr, "%i-skeleton of the HDA model, cubes of higher degree have not been computed (--max-dim)\n", maxdim);
 	printf("\"degree\"\t\"id\"");
 	for (i = 1; i <= dim; i++) 
 		printf("\t\"d^0_%i\"", i);
 	for (i = 1; i <= dim; i++) 
 		printf("\t\"d^1_%i\"", i);
 	printf("\t\"label\"\t\"initial\"\t\"final\"\t\"deadlock\"\t\"origin\"\n");
-	for (d = 0; d <= dim; d++) {			
-		i = 0;				
-		if ((cubesd = cubes[d])) {
-			do {
-				pc = (cube *) cubesd->data;				
-				pc->furtherdata = NewInt(++i);
-				cubesd = cubesd->next;
-			} while (cubesd != cubes[d]);
-		}		
-	}	
 	for (d = 0; d <= dim; d++) {		
-		if ((cubesd = cubes[d])){
-			do {
-				pc = (cube *) cubesd->data;
-				printf("\"%i\"\t\"%i.%i\"", d, d, *(int *) pc->furtherdata);	
-				for (i = 0; i < d; i++) 
-					printf("\t\"%i.%i\"", d - 1, *(int *) pc->d[0][i]->furtherdata);
-				for (i = d; i < dim; i++)
-					printf("\t\"\"");
+		lev = &cs->lev[d];
+		for (n = 0; n < lev->n; n++) {
+			printf("\"%i\"\t\"%i.%u\"", d, d, n + 1);	
+			for (k = 0; k < 2; k++) {
 				for (i = 0; i < d; i++) 
-					printf("\t\"%i.%i\"", d - 1, *(int *) pc->d[1][i]->furtherdata);
+					printf("\t\"%i.%u\"", d - 1, lev->bd[k][(size_t) n * d + i] + 1);
 				for (i = d; i < dim; i++)
 					printf("\t\"\"");
-				if (d == 0)
-					printf("\t\"()\"");						
-				else {
-					edge = pc->edges->coord;						
-					printf("\t\"(%s", ((label **) edge[0]->lab->coord)[0]->str);
-					for (j = 1; j < edge[0]->lab->dim; j++) {
+			}
+			if (d == 0)
+				printf("\t\"()\"");						
+			else {
+				edge = &lev->edges[(size_t) n * d];
+				lab = cs->lev[1].lab[edge[0]];
+				printf("\t\"(%s", ((label **) lab->coord)[0]->str);
+				for (j = 1; j < lab->dim; j++) {
+					printf(";");
+					printf("%s", ((label **) lab->coord)[j]->str);
+				}
+				for (i = 1; i < d; i++) {	
+					lab = cs->lev[1].lab[edge[i]];
+					printf(", %s", ((label **) lab->coord)[0]->str);	
+					for (j = 1; j < lab->dim; j++) {
 						printf(";");
-						printf("%s", ((label **) edge[0]->lab->coord)[j]->str);
-					}
-					for (i = 1; i < d; i++) {	
-						printf(", %s", ((label **) edge[i]->lab->coord)[0]->str);	
-						for (j = 1; j < edge[i]->lab->dim; j++) {
-							printf(";");
-							printf("%s", ((label **) edge[i]->lab->coord)[j]->str);
-						}
+						printf("%s", ((label **) lab->coord)[j]->str);
 					}
-					printf(")\"");
-				}		
-				if (d == 0 && pc->flags.ini == 1) 
-					printf("\t\"y\"");	
-				else
-					printf("\t\"\"");
-				if (d == 0 && pc->flags.fin == 1) 
-					printf("\t\"y\"");	
-				else
-					printf("\t\"\"");	
-				if (d == 0 && pc->flags.fin != 1 && !pc->s[0][0]) 
-					printf("\t\"y\"");	
-				else
-					printf("\t\"\"");
-				if (d == 0)
-					printf("\t\"%s\"", ((label **) pc->lab->coord)[0]->str);
-				else {
-					edge = pc->edges->coord;
-					printf("\t\"%s\"", ((label **) edge[0]->d[0][0]->lab->coord)[0]->str);					
 				}
-				printf("\n");								
-				cubesd = cubesd->next;
-			} while (cubesd != cubes[d]);
+				printf(")\"");
+			}		
+			if (d == 0 && lev->flags[n].ini == 1) 
+				printf("\t\"y\"");	
+			else
+				printf("\t\"\"");
+			if (d == 0 && lev->flags[n].fin == 1) 
+				printf("\t\"y\"");	
+			else
+				printf("\t\"\"");	
+			if (d == 0 && lev->flags[n].fin != 1 && lev->cooff[0][n + 1] == lev->cooff[0][n]) 
+				printf("\t\"y\"");	
+			else
+				printf("\t\"\"");
+			if (d == 0)
+				printf("\t\"%s\"", ((label **) lev->lab[n]->coord)[0]->str);
+			else 
+				printf("\t\"%s\"", ((label **) cs->lev[0].lab[cs->lev[1].bd[0][lev->edges[(size_t) n * d]]]->coord)[0]->str);					
+			printf("\n");								
 		}		
 	}	
-	for (d = 0; d <= dim; d++) {					
-		if ((cubesd = cubes[d])) {
-			do {
-				pc = (cube *) cubesd->data;				
-				DeleteInt(pc->furtherdata);
-				pc->furtherdata = NULL;
-				cubesd = cubesd->next;
-			} while (cubesd != cubes[d]);
-		}		
-	}
 }
@@ -0,0 +1,320 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File levels.c
+
+This file implements the function declared in levels.h. The cubes of a given degree are found 
+from anchors, which are the cubes of the preceding degree: every new cube has exactly one anchor, 
+namely its face d[0][degree-1]. The anchors are distributed among the threads according to their 
+origin vertices. A thread constructs the cubes of its anchors without modifying the HDA, the new 
+cubes are inserted in the HDA (and in the coface sets of their faces) after all threads have 
+finished, in the order of the anchors. The result is therefore independent of the number of 
+threads. A thread that has handled all anchors of its own vertices takes over anchors of others.
+************************************************************************************************/
+
+#include "levels.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "def.h"
+#include "vector.h"
+#include "array.h"
+#include "cube.h"
+#include "cubeset.h"
+#include "cubeindex.h"
+
+
+#define CHUNK 64	/*number of anchors taken by a thread at a time*/
+
+
+/*Work on one level*/
+
+typedef struct levelwork levelwork;
+typedef struct levelthread levelthread;
+
+struct levelwork {
+	int degree;	/*degree of the cubes to be constructed*/
+	cube **anchor;	/*cubes of degree degree-1*/
+	array *newcubes;	/*newcubes[i] contains the cubes found at anchor[i]*/
+	const cubeindex *index; 
+	int shards;	/*number of threads*/
+	int *order;	/*indexes of the anchors, the anchors of shard s are order[start[s]],..., order[start[s+1]-1]*/
+	int *start;	
+	atomic_int *next;	/*next[s] is the position in order of the next anchors of shard s to be handled*/
+};
+struct levelthread {
+	levelwork *work;
+	int shard;	/*number of the thread*/
+};
+
+
+/*Function prototypes*/
+
+static int HasBoundaryIn(const cube *pc, const array *cubes, unsigned int first); /*Returns 1 if a cube in the array from position first on has the same boundary as pc and 0 otherwise*/
+static void SquaresAt(cube *a, array *newcubes); /*See below*/
+static void HDCubesAt(cube *c, int degree, const cubeindex *index, cubeset cand[], array *newcubes); /*See below*/
+static void *LevelWorker(void *arg); /*Constructs the cubes at the anchors of one thread and, afterwards, those of other threads that remain*/
+static int FillLevel(array *cubelist[], cubeindex *index, int degree, int threads); /*Introduces the cubes of given degree >= 2 of HDA cubelist, whose cubes of lower degree have all been constructed, returns the number of cubes added*/
+
+
+/*Function implementations*/
+
+/*Returns 1 if a cube in the array from position first on has the same boundary as pc and 0 otherwise*/
+
+static int HasBoundaryIn(const cube *pc, const array *cubes, unsigned int first) {
+
+	unsigned int i;
+	const cube *pc2;
+
+	for (i = first; i < cubes->n; i++) {
+		pc2 = (cube *) cubes->el[i];
+		if (memcmp(pc->d[0], pc2->d[0], sizeof(cube *) * pc->degree) == 0 && memcmp(pc->d[1], pc2->d[1], sizeof(cube *) * pc->degree) == 0) 
+			return 1;
+	}
+	return 0;
+}
+
+
+/*Appends to newcubes the squares of an HDA whose 1-skeleton is complete that have the edge a as their face d[0][1], i.e., a is joined with the edges b that start at the origin of a and have a greater pid. The squares are not inserted in the HDA.*/
+
+static void SquaresAt(cube *a, array *newcubes) {
+
+	unsigned int j, j2, j3;
+	const cubeset *cs, *cs2, *cs3;
+	cube *b, *a2, *b2, *newcube;
+
+	cs = &a->d[0][0]->s[0][0];
+	for (j = 0; j < cs->n; j++) {
+		b = CubesetCubes(cs)[j];
+		if (((label **) b->lab->coord)[0]->num <= ((label **) a->lab->coord)[0]->num) 
+			continue;
+/*b2 is parallel to b and starts at the end of a, a2 is parallel to a and joins the end of b to the end of b2*/
+		cs2 = &a->d[1][0]->s[0][0];
+		for (j2 = 0; j2 < cs2->n; j2++) {
+			b2 = CubesetCubes(cs2)[j2];
+			if (VecCmp(b2->lab, b->lab, PTR, Labcmp) == 0) {
+				cs3 = &b->d[1][0]->s[0][0];
+				for (j3 = 0; j3 < cs3->n; j3++) {
+					a2 = CubesetCubes(cs3)[j3];
+					if (a2->d[1][0] == b2->d[1][0] && VecCmp(a2->lab, a->lab, PTR, Labcmp) == 0) {
+						newcube = NewCube(2);
+						newcube->d[0][0] = b;
+						newcube->d[0][1] = a;
+						newcube->d[1][0] = b2;
+						newcube->d[1][1] = a2;
+						((cube **) newcube->edges->coord)[0] = a;
+						((cube **) newcube->edges->coord)[1] = b;
+						AppendToArray(newcubes, newcube);
+					}
+				}
+			}
+		}
+	}
+}
+
+
+/*Appends to newcubes the cubes of given degree >= 3 of an HDA, whose cubes of lower degree have all been constructed, that have the cube c as their face d[0][degree-1]. The cube c is joined with the edges e that start at the origin of c and have a greater pid than the edges of c. The faces d[u][j] (j < degree-1) of the cube spanned by c and e are cofaces of the faces d[u][j] of c whose last edge is e (u = 0) or parallel to e (u = 1), its face d[1][degree-1] is found in index. The array cand of length 2 * (degree-1) is used for the candidates for the faces d[u][j]. The cubes are not inserted in the HDA.*/
+
+static void HDCubesAt(cube *c, int degree, const cubeindex *index, cubeset cand[], array *newcubes) {
+
+	int j, u, more, idx[2 * (degree - 1)];
+	unsigned int t, l, first;
+	const int k = degree - 1;
+	const cubeset *es, *cs;
+	cube *c2, *e, *y, *cub, *face[2][degree - 1], *bd[2][degree - 1];
+
+	es = &((cube **) c->edges->coord)[0]->d[0][0]->s[0][0];
+	for (t = 0; t < es->n; t++) {
+		e = CubesetCubes(es)[t];
+		if (((label **) e->lab->coord)[0]->num <= ((label **) ((cube **) c->edges->coord)[k - 1]->lab->coord)[0]->num) 
+			continue;
+/*determine the candidates for the faces d[u][j] (j < degree-1) of the new cube*/
+		more = 1;
+		for (j = 0; j < k && more; j++) {
+			for (u = 0; u < 2; u++) {
+				EmptyCubeset(&cand[2 * j + u]);
+				cs = &c->d[u][j]->s[0][k - 1];
+				for (l = 0; l < cs->n; l++) {
+					y = CubesetCubes(cs)[l];
+					if (u == 0 ? ((cube **) y->edges->coord)[k - 1] == e : ((label **) ((cube **) y->edges->coord)[k - 1]->lab->coord)[0]->num == ((label **) e->lab->coord)[0]->num)
+						AddToCubeset(&cand[2 * j + u], y);
+				}
+				idx[2 * j + u] = 0;
+				more = more && cand[2 * j + u].n > 0;
+			}
+		}
+/*for each choice of candidates, the cubes found for e are those of newcubes from position first on*/
+		first = newcubes->n;
+		while (more) {
+			for (j = 0; j < k; j++) {
+				for (u = 0; u < 2; u++) {
+					face[u][j] = CubesetCubes(&cand[2 * j + u])[idx[2 * j + u]];
+					bd[u][j] = face[u][j]->d[1][k - 1];
+				}
+			}
+			if ((c2 = FindCube(index, k, bd[0], bd[1]))) {
+/*create a new cube and keep it if the boundary conditions are satisfied and there is no other cube with the same boundary, those involving the faces d[0][k] and d[1][k] hold by the choice of the candidates and c2*/
+				cub = NewCube(degree);
+				cub->d[0][k] = c;
+				cub->d[1][k] = c2;
+				for (j = 0; j < k; j++) {
+					cub->d[0][j] = face[0][j];
+					cub->d[1][j] = face[1][j];
+				}
+				if (BdIdsOKExcept(cub, k) && !LookupCube(index, cub) && !HasBoundaryIn(cub, newcubes, first)) {
+					for (j = 0; j < k; j++) 
+						((cube **) cub->edges->coord)[j] = ((cube **) c->edges->coord)[j];
+					((cube **) cub->edges->coord)[k] = e;
+					AppendToArray(newcubes, cub);
+				}
+				else 
+					DeleteCube(cub);
+			}
+/*next choice of candidates, the last one changes fastest*/
+			for (j = 2 * k - 1; j >= 0 && ++idx[j] == cand[j].n; j--) 
+				idx[j] = 0;
+			more = j >= 0;
+		}
+	}
+}
+
+
+/*Constructs the cubes at the anchors of one thread and, afterwards, those of other threads that remain*/
+
+static void *LevelWorker(void *arg) {
+
+	const levelthread *lt = arg;
+	levelwork *w = lt->work;
+	int s, t, pos, end, i;
+	cubeset cand[2 * (w->degree - 1)];
+
+	for (i = 0; i < 2 * (w->degree - 1); i++) 
+		InitCubeset(&cand[i]);
+	for (t = 0; t < w->shards; t++) {
+		s = (lt->shard + t) % w->shards;
+		while ((pos = w->start[s] + atomic_fetch_add(&w->next[s], CHUNK)) < w->start[s + 1]) {
+			end = pos + CHUNK < w->start[s + 1] ? pos + CHUNK : w->start[s + 1];
+			for (i = pos; i < end; i++) {
+				if (w->degree == 2)
+					SquaresAt(w->anchor[w->order[i]], &w->newcubes[w->order[i]]);
+				else
+					HDCubesAt(w->anchor[w->order[i]], w->degree, w->index, cand, &w->newcubes[w->order[i]]);
+			}
+		}
+	}
+	for (i = 0; i < 2 * (w->degree - 1); i++) 
+		ClearCubeset(&cand[i]);
+	return NULL;
+}
+
+
+/*Introduces the cubes of given degree >= 2 of HDA cubelist, whose cubes of lower degree have all been constructed, returns the number of cubes added*/
+
+static int FillLevel(array *cubelist[], cubeindex *index, int degree, int threads) {
+
+	int newcount = 0, n, i, j, s, *count;
+	unsigned int l;
+	levelwork w;
+	levelthread *lt;
+	pthread_t *tid;
+	cube *pc;
+
+/*the anchors in the order of the cube array and their distribution by origin vertices*/
+	n = cubelist[degree - 1]->n;
+	w.degree = degree;
+	w.anchor = (cube **) cubelist[degree - 1]->el;
+	w.index = index;
+	w.shards = threads > 1 ? threads : 1;
+	if ((w.newcubes = malloc(sizeof(array) * (n > 0 ? n : 1))) == NULL || (w.order = malloc(sizeof(int) * (n > 0 ? n : 1))) == NULL 
+		|| (w.start = calloc(w.shards + 1, sizeof(int))) == NULL || (w.next = malloc(sizeof(atomic_int) * w.shards)) == NULL 
+		|| (count = calloc(w.shards, sizeof(int))) == NULL || (lt = malloc(sizeof(levelthread) * w.shards)) == NULL || (tid = malloc(sizeof(pthread_t) * w.shards)) == NULL) {
+		printf("FillLevel: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < n; i++) 
+		InitArray(&w.newcubes[i]);
+	for (i = 0; i < n; i++) 
+		w.start[(((cube **) w.anchor[i]->edges->coord)[0]->d[0][0]->id * 2654435761u) % w.shards + 1]++;
+	for (s = 0; s < w.shards; s++) {
+		w.start[s + 1] += w.start[s];
+		atomic_init(&w.next[s], 0);
+	}
+	for (i = 0; i < n; i++) {
+		s = (((cube **) w.anchor[i]->edges->coord)[0]->d[0][0]->id * 2654435761u) % w.shards;
+		w.order[w.start[s] + count[s]++] = i;
+	}
+/*construct the cubes in parallel*/
+	for (s = 0; s < w.shards; s++) {
+		lt[s].work = &w;
+		lt[s].shard = s;
+	}
+	for (s = 1; s < w.shards; s++) {
+		if (pthread_create(&tid[s], NULL, LevelWorker, &lt[s]) != 0) {
+			printf("FillLevel: Thread creation failed!\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	LevelWorker(&lt[0]);
+	for (s = 1; s < w.shards; s++) 
+		pthread_join(tid[s], NULL);
+/*insert the new cubes in the order of their anchors*/
+	for (i = 0; i < n; i++) {
+		for (l = 0; l < w.newcubes[i].n; l++) {
+			pc = (cube *) w.newcubes[i].el[l];
+			InsertCube(pc, cubelist);
+			for (j = 0; j < degree; j++) {
+				AddToCubeset(&pc->d[0][j]->s[0][j], pc);
+				AddToCubeset(&pc->d[1][j]->s[1][j], pc);
+			}
+			AddToCubeindex(index, pc);
+			newcount++;
+		}
+		ClearArray(&w.newcubes[i], NULL);
+	}
+	free(w.newcubes);
+	free(w.order);
+	free(w.start);
+	free(w.next);
+	free(count);
+	free(lt);
+	free(tid);
+	return newcount;
+}
+
+
+/*Completes HDA cubelist, whose 1-skeleton is complete, level by level by introducing all cubes of degree 2,..., n using the given number of threads, adds the new cubes to index, returns the dimension of the highest cube added, returns -1 if no cube is added*/
+
+int FillLevels(array *cubelist[], cubeindex *index, int n, int threads) {
+
+	int count = 1, dim = 1;
+
+	while (count > 0 && dim < n && cubelist[dim]->n > 0) {
+		count = FillLevel(cubelist, index, dim + 1, threads);
+		if (count > 0)
+			dim++;
+	}
+	return dim > 1 ? dim : -1;
+}
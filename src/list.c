@@ -84,6 +84,31 @@ void Pop(list **l, void (*del)(void *)) {
 } 
 
 
+/*Removes the first node with data p from the list without deleting the data, the next node becomes the head if the head is removed*/
+
+void RemoveElement(list **l, const void *p) {
+
+	list *node;
+
+	if (l && *l) {
+		node = *l;
+		do {
+			if (node->data == p) {
+				if (node == *l) 
+					Pop(l, NULL);
+				else {
+					node->prev->next = node->next;
+					node->next->prev = node->prev;
+					free(node);
+				}
+				return;
+			}
+			node = node->next;
+		} while (node != *l);
+	}
+}
+
+
 /*Deletes list, deletes data using the del function*/
 
 void DeleteList(list **l, void (*del)(void *)) {
@@ -215,75 +240,6 @@ void ConcatLists(list **list1, const list *list2) {
 }
 
 
-/*Produces the cartesian product of two lists of vectors of elements of the given type*/
-
-list *Product(const list *list1, const list *list2, int type) {
-	
-	int i;
-	const list *l1, *l2;
-	list *prodlist = NULL;
-	const vector *vec1, *vec2;
-	vector *vec;
-		
-	if(list1 && list2) {
-		l1 = list1;
-		do {
-			vec1 = (vector *) l1->data;
-			l2 = list2;
-			do {				
-				vec2 = (vector *) l2->data;	
-				switch (type) {
-					case INT: 
-						vec = NewVector(vec1->dim + vec2->dim, sizeof(int));
-						for (i = 0; i < vec1->dim; i++)
-							((int *) vec->coord)[i] = ((int *) vec1->coord)[i];
-						for (i = 0; i < vec2->dim; i++)
-							((int *) vec->coord)[i + vec1->dim] = ((int *) vec2->coord)[i];
-						break;
-					default:
-						vec = NewVector(vec1->dim + vec2->dim, sizeof(void *));
-						for (i = 0; i < vec1->dim; i++)
-							((void **) vec->coord)[i] = ((void **) vec1->coord)[i];
-						for (i = 0; i < vec2->dim; i++)
-							((void **) vec->coord)[i + vec1->dim] = ((void **) vec2->coord)[i];
-						break;
-				} 
-				prodlist = InsertElement(vec, prodlist);
-				l2 = l2->next;
-			} while (l2 != list2);
-			l1 = l1->next;
-		} while (l1 != list1);
-	}
-	return prodlist;
-}
-
- 
-/*veclist is seen as a matrix with vectors as lines, computes the transposite of this matrix, all vectors must be integer vectors of the same dimension*/
-
-list *Transpose(const list *veclist) {
-
-	int i, j;
-	const list *vlist;
-	list *transpose = NULL;	
-	vector *vec, *v;
-	 
-	if (veclist) {		 
-		for (j = 0; j < ((vector *) veclist->data)->dim; j++) { 
-			vec = NewVector(NumberOfElements(veclist), sizeof(int));
-			i = 0;
-			vlist = veclist;
-			do {
-				v = (vector *) vlist->data;
-				((int *) vec->coord)[i++] = ((int *) v->coord)[j];
-				vlist = vlist->next;
-			} while (vlist != veclist);
-			transpose = InsertElement(vec, transpose);
-		}
-	}
-	return transpose;
-} 
-
-
 /*Transforms list into list of 1-dimensional vectors*/
 
 list *AsVectorList(const list *l) {
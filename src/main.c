@@ -33,26 +33,40 @@ This file contains the main function.
 #include "def.h"
 #include "vector.h"
 #include "list.h"
+#include "array.h"
 #include "pgraph.h"
 #include "cube.h"
+#include "cubeindex.h"
+#include "cubestore.h"
+#include "verify.h"
 #include "io.h"
 #include "hda.h"
+#include "codegen.h"
+#include "minimize.h"
+#include "exprdag.h"
+#include "symbolic.h"
 #include "pml2pg.tab.h" 
 
 
 extern void ParsePML(FILE *fp, list **varlist, programgraph *pgraph, list **sections, const int create);
-unsigned int out = 0, inp = 0; 
+unsigned int out = 0, inp = 0, build = 0, threads = 1, maxdim = 0, order = 0, reduce = 0, verify = 0, codegen = 0, minimize = 0, symbolic = 0; 
  
 
 int main(int argc, char *argv[]) {
 	
-	int i, filecount = 0, n, dim = 0;
+	int i, filecount = 0, n, top, dim = 0, errors = 0, truncated;
 	char inputfile[argc][STRL];	
 	vector *pgvec, *hda;
 	programgraph **pg;
 	FILE *fp;
-	list *varlist = NULL, *sections = NULL, **cubes;	
+	list *varlist = NULL, *sections = NULL;	
+	array **cubes, *vars;
+	cubeindex *index;
+	cubestore *store;
+	void *native = NULL;
+	exprdag *dag = NULL;
 	
+	InitVectorKernels();
 	for (i = 0; i < argc; i++) 
 		strcpy(inputfile[i], "");								
 /*options and input files*/
@@ -67,12 +81,45 @@ int main(int argc, char *argv[]) {
 			out = OPTION_t;		
 		else if (strcmp(argv[i], "--old") == 0) 
 			inp = OPTION_old;		
+		else if (strcmp(argv[i], "--batch") == 0) 
+			build = OPTION_batch;		
+		else if (strcmp(argv[i], "--threads") == 0) {
+			if (i + 1 >= argc || atoi(argv[i + 1]) <= 0) {
+				printf("Error: --threads needs a positive integer\n");
+				exit(EXIT_FAILURE);
+			}
+			build = OPTION_batch;
+			threads = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--verify") == 0) 
+			verify = OPTION_verify;
+		else if (strcmp(argv[i], "--reduce") == 0) 
+			reduce = OPTION_reduce;
+		else if (strcmp(argv[i], "--reorder") == 0) 
+			order = OPTION_reorder;
+		else if (strcmp(argv[i], "--codegen") == 0) 
+			codegen = OPTION_codegen;
+		else if (strcmp(argv[i], "--minimize") == 0) 
+			minimize = OPTION_minimize;
+		else if (strcmp(argv[i], "--symbolic-count") == 0) 
+			symbolic = OPTION_symbolic;
+		else if (strcmp(argv[i], "--max-dim") == 0) {
+			if (i + 1 >= argc || atoi(argv[i + 1]) <= 0) {
+				printf("Error: --max-dim needs a positive integer\n");
+				exit(EXIT_FAILURE);
+			}
+			maxdim = atoi(argv[++i]);
+		}
 		else 
 			strcpy(inputfile[filecount++], argv[i]);
 	}
 	if (filecount < 1) {
 		printf("Error: no input file\n");
 		exit(EXIT_FAILURE);
+	}
+	if (symbolic == OPTION_symbolic && out == OPTION_i) {
+		printf("Error: --symbolic-count cannot be combined with -i\n");
+		exit(EXIT_FAILURE);
 	}				
 /*program graph input*/ 
     if (inp == OPTION_old) {    		    
@@ -109,25 +156,62 @@ int main(int argc, char *argv[]) {
 		}								
 	} 	
 /*HDA construction and output*/		
-	hda = NewVector(n + 1, sizeof(list *));	
-	cubes = (list **) hda->coord;		
-	for (i = 0; i <= n; i++) 		
-		cubes[i] = NULL;												
-	if (out != OPTION_i) 
-		dim = MakeHDA(pgvec, cubes, varlist);
-	if (out == OPTION_c)
-		PrintChainComplex(cubes, dim);																							 
-	else if (out == OPTION_t)
-		PrintHDA(cubes, dim);
-	else 		    			
-		PrintSystemHDA(pgvec, varlist, cubes, dim);												
+	top = maxdim > 0 && maxdim < n ? maxdim : n;
+	hda = NewVector(top + 1, sizeof(array *));	
+	cubes = (array **) hda->coord;		
+	for (i = 0; i <= top; i++) 		
+		cubes[i] = NewArray();												
+	index = NewCubeindex(top);
+	vars = ListToArray(varlist);
+	if (inp != OPTION_old) {
+		dag = NewExprdag();
+		for (i = 0; i < n; i++) {
+			PrunePG(pg[i]);
+			if (minimize == OPTION_minimize)
+				MinimizePG(pg[i]);
+			EnterPG(pg[i], vars, dag);
+		}
+/*the shared subexpressions are known once all program graphs are entered*/
+		for (i = 0; i < n; i++)
+			CompilePG(pg[i], vars, dag);
+	}
+	else
+		for (i = 0; i < n; i++)
+			TabulatePG(pg[i], vars);
+	if (codegen == OPTION_codegen && inp != OPTION_old && out != OPTION_i && symbolic != OPTION_symbolic)
+		native = LoadNativeCode(pgvec, vars);
+	if (symbolic == OPTION_symbolic)
+		SymbolicCount(pgvec, vars);
+	else if (out != OPTION_i) 
+		dim = MakeHDA(pgvec, cubes, index, vars, dag);
+	UnloadNativeCode(native, pgvec);
+	truncated = top < n && dim >= top;	/*cubes of degree top + 1 would have been computed without --max-dim*/
+	if (verify == OPTION_verify) 
+		errors = VerifyHDA(cubes, dim, threads);
+	store = StoreHDA(cubes, dim);
+	if (reduce == OPTION_reduce) 
+		ReduceCubestore(store);
+	if (order == OPTION_reorder) 
+		ReorderCubestore(store);
+	DeleteCubeindex(index);
+	for (i = 0; i <= top; i++) 
+		DeleteArray(cubes[i], DeleteCube);		
+	DeleteVector(hda);			
+	DeleteArray(vars, NULL);
+	DeleteExprdag(dag);
+	if (symbolic != OPTION_symbolic) {
+		if (out == OPTION_c)
+			PrintChainComplex(store, truncated);																							 
+		else if (out == OPTION_t)
+			PrintHDA(store, truncated);
+		else 		    			
+			PrintSystemHDA(pgvec, varlist, store, truncated);
+	}												
 /*clear memory*/
 	for (i = 0; i < n; i++) 
 		DeletePG(pg[i]);
 	DeleteVector(pgvec);	
 	DeleteList(&varlist, DeleteVariable);		
-	for (i = 0; i <= dim; i++) 
-		DeleteList(&cubes[i], DeleteCube);		
-	DeleteVector(hda);			
-	return 0;
+	DeleteCubestore(store);
+	return errors > 0 ? EXIT_FAILURE : 0;
 }
@@ -0,0 +1,480 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File mdd.c
+
+This file implements the functions declared in mdd.h.
+************************************************************************************************/
+
+#include "mdd.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "def.h"
+#include "vector.h"
+#include "hashmap.h"
+
+
+#define MDD_MINSIZE 64	/*initial number of allocated nodes*/
+
+#define MDD_AND 0	/*operations of Apply*/
+#define MDD_OR 1
+#define MDD_MINUS 2
+
+
+/*Function prototypes*/
+
+static int RowCmp(const void *p, const void *q); /*Compares rows r, whose digits are r[1],..., r[r[0]], lexicographically for qsort*/
+static int Build(mdd *m, const int *ulev, int u, int t, int *const *rec, int lo, int hi); /*Returns the node of the set of assignments given by the rows rec[lo],..., rec[hi-1] on the levels ulev[t],..., ulev[u-1]*/
+static int Apply(mdd *m, int op, int a, int b, hashmap *memo); /*Returns the node of the intersection, union or difference (op) of the sets of nodes a and b, memo maps the triples (op, a, b) already computed to the result plus 1*/
+static int Operate(mdd *m, int op, int a, int b); /*Applies op to the nodes a and b with a new memo table*/
+static uint64_t Skipped(const mdd *m, int from, int to); /*Returns the number of assignments of the bounded levels from,..., to-1*/
+static uint64_t Count(const mdd *m, int a, uint64_t *count, char *done); /*Returns the number of assignments of the levels of node a and below in the set of node a, count[a] is valid if done[a] is set*/
+static int Walk(const mdd *m, int a, int l, int *digit, int (*visit)(const int [], void *), void *data, int *calls); /*Enumerates the assignments of the levels l,..., levels-1 in the set of node a, which is of level l or greater, returns 0 if visit has returned 0 and 1 otherwise*/
+
+
+/*Function implementations*/
+
+/*Creates new MDD with the terminal nodes only for the given levels and numbers of digits*/
+
+mdd *NewMdd(int levels, const int *radix) {
+
+	mdd *m;
+	int i;
+
+	if ((m = malloc(sizeof(mdd))) == NULL || (m->radix = malloc(sizeof(int) * (levels > 0 ? levels : 1))) == NULL 
+		|| (m->level = malloc(sizeof(int) * MDD_MINSIZE)) == NULL || (m->arity = malloc(sizeof(int) * MDD_MINSIZE)) == NULL 
+		|| (m->digit = malloc(sizeof(int *) * MDD_MINSIZE)) == NULL || (m->child = malloc(sizeof(int *) * MDD_MINSIZE)) == NULL) {
+		printf("NewMdd: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	m->levels = levels;
+	for (i = 0; i < levels; i++)
+		m->radix[i] = radix[i];
+	m->size = MDD_MINSIZE;
+	m->n = 2;
+	for (i = MDD_FALSE; i <= MDD_TRUE; i++) {
+		m->level[i] = levels;
+		m->arity[i] = 0;
+		m->digit[i] = m->child[i] = NULL;
+	}
+	m->unique = NewHashmap(INT);
+	return m;
+}
+
+
+/*Deletes given MDD*/
+
+void DeleteMdd(mdd *m) {
+
+	int i;
+
+	if (m) {
+		for (i = 0; i < m->n; i++) {
+			free(m->digit[i]);
+			free(m->child[i]);
+		}
+		free(m->digit);
+		free(m->child);
+		free(m->arity);
+		free(m->level);
+		free(m->radix);
+		DeleteHashmap(m->unique, DeleteVector);
+		free(m);
+	}
+}
+
+
+/*Returns the node of the bounded level l whose child for digit d is child[d], or the child if all children are equal*/
+
+int MddNode(mdd *m, int l, const int *child) {
+
+	const int r = m->radix[l];
+	int digit[r > 0 ? r : 1], d;
+
+	for (d = 0; d < r; d++)
+		digit[d] = d;
+	return MddSparseNode(m, l, r, digit, child);
+}
+
+
+/*Returns the node of level l whose child for the digit digit[j] is child[j] for j < k, where the digits increase, and MDD_FALSE for the other digits*/
+
+int MddSparseNode(mdd *m, int l, int k, const int *digit, const int *child) {
+
+	int keycoord[2 * k + 2], j, a = 0;
+	vector key = {0, keycoord}, *newkey;
+	void *i;
+
+	for (j = 0; j < k; j++) {
+		if (child[j] != MDD_FALSE) {
+			keycoord[2 + 2 * a] = digit[j];
+			keycoord[3 + 2 * a++] = child[j];
+		}
+	}
+	if (a == 0)
+		return MDD_FALSE;
+/*a bounded level whose digits all lead to the same child is skipped*/
+	if (a == m->radix[l]) {
+		for (j = 1; j < a && keycoord[3 + 2 * j] == keycoord[3]; j++)
+			;
+		if (j == a)
+			return keycoord[3];
+	}
+	keycoord[0] = l;
+	keycoord[1] = a;
+	key.dim = 2 * a + 2;
+	if ((i = LookupKey(m->unique, &key)))
+		return (int) (uintptr_t) i - 1;
+	if (m->n == m->size) {
+		m->size *= 2;
+		if ((m->level = realloc(m->level, sizeof(int) * m->size)) == NULL || (m->arity = realloc(m->arity, sizeof(int) * m->size)) == NULL 
+			|| (m->digit = realloc(m->digit, sizeof(int *) * m->size)) == NULL || (m->child = realloc(m->child, sizeof(int *) * m->size)) == NULL) {
+			printf("MddSparseNode: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+	if ((m->digit[m->n] = malloc(sizeof(int) * a)) == NULL || (m->child[m->n] = malloc(sizeof(int) * a)) == NULL) {
+		printf("MddSparseNode: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	m->level[m->n] = l;
+	m->arity[m->n] = a;
+	for (j = 0; j < a; j++) {
+		m->digit[m->n][j] = keycoord[2 + 2 * j];
+		m->child[m->n][j] = keycoord[3 + 2 * j];
+	}
+	newkey = NewVector(key.dim, sizeof(int));
+	memcpy(newkey->coord, keycoord, sizeof(int) * key.dim);
+	AddToHashmap(m->unique, newkey, (void *) (uintptr_t) (m->n + 1));
+	return m->n++;
+}
+
+
+/*Returns the child of node a for digit d of level l, which is a itself if a is of a greater level*/
+
+int MddChild(const mdd *m, int a, int l, int d) {
+
+	int lo = 0, hi, mid;
+
+	if (m->level[a] != l)
+		return a;
+	hi = m->arity[a] - 1;
+	while (lo <= hi) {
+		mid = lo + (hi - lo) / 2;
+		if (m->digit[a][mid] == d)
+			return m->child[a][mid];
+		if (m->digit[a][mid] < d)
+			lo = mid + 1;
+		else
+			hi = mid - 1;
+	}
+	return MDD_FALSE;
+}
+
+
+/*Compares rows r, whose digits are r[1],..., r[r[0]], lexicographically for qsort*/
+
+static int RowCmp(const void *p, const void *q) {
+
+	const int *a = *(int *const *) p, *b = *(int *const *) q;
+	int j;
+
+	for (j = 1; j <= a[0]; j++) {
+		if (a[j] != b[j])
+			return a[j] < b[j] ? -1 : 1;
+	}
+	return 0;
+}
+
+
+/*Returns the node of the set of assignments given by the rows rec[lo],..., rec[hi-1] on the levels ulev[t],..., ulev[u-1]*/
+
+static int Build(mdd *m, const int *ulev, int u, int t, int *const *rec, int lo, int hi) {
+
+	int digit[hi > lo ? hi - lo : 1], child[hi > lo ? hi - lo : 1], k = 0, i, j;
+
+	if (lo >= hi)
+		return MDD_FALSE;
+	if (t == u)
+		return MDD_TRUE;
+	for (i = lo; i < hi; i = j) {
+		for (j = i; j < hi && rec[j][t + 1] == rec[i][t + 1]; j++)
+			;
+		digit[k] = rec[i][t + 1];
+		child[k++] = Build(m, ulev, u, t + 1, rec, i, j);
+	}
+	return MddSparseNode(m, ulev[t], k, digit, child);
+}
+
+
+/*Returns the node of the set of assignments that give level lev[j] the digit row[i][j] for j = 0,..., k-1 and some i < count, every unbounded level must occur in lev*/
+
+int MddFromRows(mdd *m, const int *lev, int k, int *const *row, int count) {
+
+	int ulev[k > 0 ? k : 1], col[k > 0 ? k : 1], u = 0, i, j, c, valid, a, **rec, n = 0;
+	char set[k > 0 ? k : 1];
+
+/*the distinct levels in increasing order, col[j] is the position of lev[j] among them*/
+	for (j = 0; j < k; j++) {
+		for (c = 0; c < u && ulev[c] < lev[j]; c++)
+			;
+		if (c == u || ulev[c] != lev[j]) {
+			memmove(&ulev[c + 1], &ulev[c], sizeof(int) * (u - c));
+			ulev[c] = lev[j];
+			u++;
+		}
+	}
+	for (j = 0; j < k; j++)
+		for (col[j] = 0; ulev[col[j]] != lev[j]; col[j]++)
+			;
+/*rows whose digits are out of range or which give a level two digits are dropped*/
+	if ((rec = malloc(sizeof(int *) * (count > 0 ? count : 1))) == NULL) {
+		printf("MddFromRows: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	for (i = 0; i < count; i++) {
+		if ((rec[n] = malloc(sizeof(int) * (u + 1))) == NULL) {
+			printf("MddFromRows: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		rec[n][0] = u;
+		memset(set, 0, sizeof(char) * u);
+		for (j = 0, valid = 1; j < k && valid; j++) {
+			c = col[j];
+			if ((m->radix[lev[j]] != MDD_UNBOUNDED && (row[i][j] < 0 || row[i][j] >= m->radix[lev[j]])) || (set[c] && rec[n][c + 1] != row[i][j]))
+				valid = 0;
+			rec[n][c + 1] = row[i][j];
+			set[c] = 1;
+		}
+		if (valid)
+			n++;
+		else
+			free(rec[n]);
+	}
+	qsort(rec, n, sizeof(int *), RowCmp);
+	a = Build(m, ulev, u, 0, rec, 0, n);
+	for (i = 0; i < n; i++)
+		free(rec[i]);
+	free(rec);
+	return a;
+}
+
+
+/*Returns the node of the intersection, union or difference (op) of the sets of nodes a and b, memo maps the triples (op, a, b) already computed to the result plus 1*/
+
+static int Apply(mdd *m, int op, int a, int b, hashmap *memo) {
+
+	int keycoord[3], l, d, i, j, k, c, *digit, *child;
+	vector key = {3, keycoord}, *newkey;
+	void *r;
+
+	switch (op) {
+		case MDD_AND:
+			if (a == MDD_FALSE || b == MDD_FALSE)
+				return MDD_FALSE;
+			if (a == MDD_TRUE || a == b)
+				return b;
+			if (b == MDD_TRUE)
+				return a;
+			break;
+		case MDD_OR:
+			if (a == MDD_FALSE || a == b)
+				return b;
+			if (b == MDD_FALSE)
+				return a;
+			if (a == MDD_TRUE || b == MDD_TRUE)
+				return MDD_TRUE;
+			break;
+		default:
+			if (a == MDD_FALSE || a == b || b == MDD_TRUE)
+				return MDD_FALSE;
+			if (b == MDD_FALSE)
+				return a;
+			break;
+	}
+	keycoord[0] = op;
+	keycoord[1] = op != MDD_MINUS && b < a ? b : a;
+	keycoord[2] = op != MDD_MINUS && b < a ? a : b;
+	if ((r = LookupKey(memo, &key)))
+		return (int) (uintptr_t) r - 1;
+	l = m->level[a] < m->level[b] ? m->level[a] : m->level[b];
+/*the candidate digits: all digits of a bounded level, the digits of the children of a and b for an unbounded one*/
+	k = m->radix[l] != MDD_UNBOUNDED ? m->radix[l] : (m->level[a] == l ? m->arity[a] : 0) + (m->level[b] == l ? m->arity[b] : 0);
+	if ((digit = malloc(sizeof(int) * (k > 0 ? k : 1))) == NULL || (child = malloc(sizeof(int) * (k > 0 ? k : 1))) == NULL) {
+		printf("Apply: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	if (m->radix[l] != MDD_UNBOUNDED)
+		for (d = 0; d < k; d++)
+			digit[d] = d;
+	else {
+		for (i = j = k = 0; (m->level[a] == l && i < m->arity[a]) || (m->level[b] == l && j < m->arity[b]); ) {
+			if (m->level[b] != l || j == m->arity[b] || (m->level[a] == l && i < m->arity[a] && m->digit[a][i] < m->digit[b][j]))
+				digit[k++] = m->digit[a][i++];
+			else if (m->level[a] != l || i == m->arity[a] || m->digit[b][j] < m->digit[a][i])
+				digit[k++] = m->digit[b][j++];
+			else {
+				digit[k++] = m->digit[a][i++];
+				j++;
+			}
+		}
+	}
+	for (d = 0; d < k; d++)
+		child[d] = Apply(m, op, MddChild(m, a, l, digit[d]), MddChild(m, b, l, digit[d]), memo);
+	c = MddSparseNode(m, l, k, digit, child);
+	free(digit);
+	free(child);
+	newkey = NewVector(3, sizeof(int));
+	memcpy(newkey->coord, keycoord, sizeof(int) * 3);
+	AddToHashmap(memo, newkey, (void *) (uintptr_t) (c + 1));
+	return c;
+}
+
+
+/*Applies op to the nodes a and b with a new memo table*/
+
+static int Operate(mdd *m, int op, int a, int b) {
+
+	hashmap *memo = NewHashmap(INT);
+	int c = Apply(m, op, a, b, memo);
+
+	DeleteHashmap(memo, DeleteVector);
+	return c;
+}
+
+
+/*Returns the node of the intersection of the sets of nodes a and b*/
+
+int MddAnd(mdd *m, int a, int b) {
+
+	return Operate(m, MDD_AND, a, b);
+}
+
+
+/*Returns the node of the union of the sets of nodes a and b*/
+
+int MddOr(mdd *m, int a, int b) {
+
+	return Operate(m, MDD_OR, a, b);
+}
+
+
+/*Returns the node of the difference of the sets of nodes a and b*/
+
+int MddMinus(mdd *m, int a, int b) {
+
+	return Operate(m, MDD_MINUS, a, b);
+}
+
+
+/*Returns the number of assignments of the bounded levels from,..., to-1*/
+
+static uint64_t Skipped(const mdd *m, int from, int to) {
+
+	uint64_t n = 1;
+	int l;
+
+	for (l = from; l < to; l++)
+		n *= m->radix[l] != MDD_UNBOUNDED ? (uint64_t) m->radix[l] : 1;
+	return n;
+}
+
+
+/*Returns the number of assignments of the levels of node a and below in the set of node a, count[a] is valid if done[a] is set*/
+
+static uint64_t Count(const mdd *m, int a, uint64_t *count, char *done) {
+
+	uint64_t n = 0;
+	int j;
+
+	if (a == MDD_FALSE || a == MDD_TRUE)
+		return a == MDD_TRUE;
+	if (done[a])
+		return count[a];
+	for (j = 0; j < m->arity[a]; j++)
+		n += Skipped(m, m->level[a] + 1, m->level[m->child[a][j]]) * Count(m, m->child[a][j], count, done);
+	count[a] = n;
+	done[a] = 1;
+	return n;
+}
+
+
+/*Returns the number of assignments in the set of node a*/
+
+uint64_t MddCount(const mdd *m, int a) {
+
+	uint64_t *count, n;
+	char *done;
+
+	if ((count = malloc(sizeof(uint64_t) * m->n)) == NULL || (done = calloc(m->n, sizeof(char))) == NULL) {
+		printf("MddCount: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	n = Skipped(m, 0, m->level[a]) * Count(m, a, count, done);
+	free(count);
+	free(done);
+	return n;
+}
+
+
+/*Enumerates the assignments of the levels l,..., levels-1 in the set of node a, which is of level l or greater, returns 0 if visit has returned 0 and 1 otherwise*/
+
+static int Walk(const mdd *m, int a, int l, int *digit, int (*visit)(const int [], void *), void *data, int *calls) {
+
+	int d, j;
+
+	if (l == m->levels) {
+		(*calls)++;
+		return visit(digit, data);
+	}
+	if (m->level[a] == l) {
+		for (j = 0; j < m->arity[a]; j++) {
+			digit[l] = m->digit[a][j];
+			if (!Walk(m, m->child[a][j], l + 1, digit, visit, data, calls))
+				return 0;
+		}
+	}
+	else if (m->radix[l] != MDD_UNBOUNDED) {
+		for (d = 0; d < m->radix[l]; d++) {
+			digit[l] = d;
+			if (!Walk(m, a, l + 1, digit, visit, data, calls))
+				return 0;
+		}
+	}
+	return 1;
+}
+
+
+/*Calls visit for every assignment digit[0],..., digit[levels-1] in the set of node a, in lexicographic order, until visit returns 0, returns the number of calls*/
+
+int MddEnumerate(const mdd *m, int a, int (*visit)(const int digit[], void *data), void *data) {
+
+	int digit[m->levels > 0 ? m->levels : 1], calls = 0;
+
+	if (a != MDD_FALSE)
+		Walk(m, a, 0, digit, visit, data, &calls);
+	return calls;
+}
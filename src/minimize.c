@@ -0,0 +1,222 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File minimize.c
+
+This file implements the functions declared in minimize.h. The bisimilarity classes are 
+computed by partition refinement: starting from the partition separating the final location, 
+each location is assigned the signature formed by its class and the set of pairs (label class, 
+class of the end location) of its outgoing transitions, and the locations are repartitioned by 
+their signatures until the number of classes is stable. Each class is represented by its 
+location of least index.
+************************************************************************************************/
+
+#include "minimize.h"
+#include <stdlib.h>
+#include "def.h"
+#include "vector.h"
+#include "list.h"
+#include "array.h"
+#include "hashmap.h"
+#include "pgraph.h"
+
+
+/*Function prototypes*/
+
+static int SameAst(const ast *exp1, const ast *exp2); /*Returns 1 if the expressions are equal (up to parentheses) and 0 otherwise*/
+static int SameLabel(const transition *trans1, const transition *trans2); /*Returns 1 if the transitions have the same guard and action and 0 otherwise*/
+static int Paircmp(const void *p1, const void *p2); /*Compares pairs of integers lexicographically*/
+static int Refine(const int block[], int newblock[], int n, const int first[], const int tclass[], const int dst[]); /*Computes the refinement newblock of the partition block of the n locations, first[i],..., first[i+1]-1 are the outgoing transitions of location i, returns the number of classes*/
+
+
+/*Function implementations*/
+
+/*Returns 1 if the expressions are equal (up to parentheses) and 0 otherwise*/
+
+static int SameAst(const ast *exp1, const ast *exp2) {
+
+	if (!exp1 || !exp2)
+		return exp1 == exp2;
+	if (exp1->type != exp2->type)
+		return 0;
+	switch (exp1->type) {
+		case VAR:
+			return exp1->node.var == exp2->node.var;
+		case NUM:
+			return exp1->node.num == exp2->node.num;
+		default:
+			return exp1->node.op == exp2->node.op && SameAst(exp1->l, exp2->l) && SameAst(exp1->r, exp2->r);
+	}
+}
+
+
+/*Returns 1 if the transitions have the same guard and action and 0 otherwise*/
+
+static int SameLabel(const transition *trans1, const transition *trans2) {
+
+	return trans1->act == trans2->act && SameAst(trans1->cond->exp, trans2->cond->exp);
+}
+
+
+/*Compares pairs of integers lexicographically*/
+
+static int Paircmp(const void *p1, const void *p2) {
+
+	const int *a = p1, *b = p2;
+
+	return a[0] != b[0] ? (a[0] > b[0]) - (a[0] < b[0]) : (a[1] > b[1]) - (a[1] < b[1]);
+}
+
+
+/*Computes the refinement newblock of the partition block of the n locations, first[i],..., first[i+1]-1 are the outgoing transitions of location i, returns the number of classes*/
+
+static int Refine(const int block[], int newblock[], int n, const int first[], const int tclass[], const int dst[]) {
+
+	hashmap *sigs = NewHashmap(INT);	/*maps the signatures to their classes*/
+	int i, j, k, count = 0, ids[n > 0 ? n : 1], *sig;
+	vector *v;
+	const int *id;
+
+	for (i = 0; i < n; i++) {
+		v = NewVector(1 + 2 * (first[i + 1] - first[i]), sizeof(int));
+		sig = v->coord;
+		sig[0] = block[i];
+		for (j = first[i], k = 1; j < first[i + 1]; j++, k += 2) {
+			sig[k] = tclass[j];
+			sig[k + 1] = block[dst[j]];
+		}
+		qsort(&sig[1], first[i + 1] - first[i], 2 * sizeof(int), Paircmp);
+/*remove duplicate pairs*/
+		for (j = 3, k = 3; j < v->dim; j += 2) {
+			if (sig[j] != sig[k - 2] || sig[j + 1] != sig[k - 1]) {
+				sig[k] = sig[j];
+				sig[k + 1] = sig[j + 1];
+				k += 2;
+			}
+		}
+		v->dim = v->dim < k ? v->dim : k;
+		if ((id = LookupKey(sigs, v))) {
+			newblock[i] = *id;
+			DeleteVector(v);
+		}
+		else {
+			ids[count] = count;
+			AddToHashmap(sigs, v, &ids[count]);
+			newblock[i] = count++;
+		}
+	}
+	DeleteHashmap(sigs, DeleteVector);
+	return count;
+}
+
+
+/*Merges the bisimilar locations of pg into one location each and removes the duplicate transitions arising from this, returns the number of merged locations*/
+
+int MinimizePG(programgraph *pg) {
+
+	array *locs = ListToArray(pg->loclist), *trans = ListToArray(pg->translist);
+	const int n = locs->n, m = trans->n, size = n > 0 ? n : 1, tsize = m > 0 ? m : 1;
+	int i, j, k, nblocks, count, pos[size], first[n + 1], fill[size], block[size], newblock[size], label[tsize], start[tsize], end[tsize], tclass[tsize], dst[tsize];
+	location *rep[size], *loc;
+	transition *t;
+	hashmap *locpos = NewHashmap(PTR), *seen = NewHashmap(INT);
+	vector *key;
+
+/*positions of the locations and of the start and end locations of the transitions, label classes of the transitions*/
+	for (i = 0; i < n; i++) {
+		pos[i] = i;
+		AddToHashmap(locpos, locs->el[i], &pos[i]);
+	}
+	for (j = 0; j < m; j++) {
+		t = (transition *) trans->el[j];
+		start[j] = *(int *) LookupKey(locpos, t->loc[0]);
+		end[j] = *(int *) LookupKey(locpos, t->loc[1]);
+		for (k = 0; k < j && !SameLabel(t, trans->el[k]); k++)
+			;
+		label[j] = k < j ? label[k] : j;
+	}
+/*outgoing transitions of location i at the positions first[i],..., first[i+1]-1 of tclass and dst*/
+	for (i = 0; i <= n; i++)
+		first[i] = 0;
+	for (j = 0; j < m; j++)
+		first[start[j] + 1]++;
+	for (i = 0; i < n; i++) {
+		first[i + 1] += first[i];
+		fill[i] = first[i];
+	}
+	for (j = 0; j < m; j++) {
+		tclass[fill[start[j]]] = label[j];
+		dst[fill[start[j]]++] = end[j];
+	}
+/*partition refinement*/
+	for (i = 0; i < n; i++)
+		block[i] = locs->el[i] == pg->loc_1;
+	nblocks = 0;
+	while ((count = Refine(block, newblock, n, first, tclass, dst)) != nblocks) {
+		nblocks = count;
+		for (i = 0; i < n; i++)
+			block[i] = newblock[i];
+	}
+/*representatives of the classes*/
+	for (i = 0; i < nblocks; i++)
+		rep[i] = NULL;
+	for (i = 0; i < n; i++) {
+		loc = (location *) locs->el[i];
+		if (!rep[block[i]] || loc->index < rep[block[i]]->index)
+			rep[block[i]] = loc;
+	}
+/*the transitions of the representatives are redirected to representatives, the other transitions and the duplicates are removed*/
+	for (j = 0; j < m; j++) {
+		t = (transition *) trans->el[j];
+		key = NewVector(3, sizeof(int));
+		((int *) key->coord)[0] = start[j];
+		((int *) key->coord)[1] = label[j];
+		((int *) key->coord)[2] = block[end[j]];
+		if (rep[block[start[j]]] != t->loc[0] || !AddToHashmap(seen, key, NULL)) {
+			DeleteVector(key);
+			RemoveTransition(pg, t);
+			pg->no_mergedtrans++;
+		}
+		else if (t->loc[1] != rep[block[end[j]]]) {
+			RemoveElement(&t->loc[1]->intranslist, t);
+			t->loc[1] = rep[block[end[j]]];
+			t->loc[1]->intranslist = InsertElement(t, t->loc[1]->intranslist);
+		}
+	}
+	for (i = 0; i < n; i++) {
+		loc = (location *) locs->el[i];
+		if (rep[block[i]] != loc) {
+			if (pg->loc_0 == loc)
+				pg->loc_0 = rep[block[i]];
+			RemoveElement(&pg->loclist, loc);
+			DeleteLocation(loc);
+		}
+	}
+	pg->no_mergedlocs += n - nblocks;
+	DeleteHashmap(seen, DeleteVector);
+	DeleteHashmap(locpos, NULL);
+	DeleteArray(locs, NULL);
+	DeleteArray(trans, NULL);
+	return n - nblocks;
+}
@@ -33,8 +33,20 @@ This file implements the functions declared in pgraph.h.
 #include <string.h>
 #include "vector.h"
 #include "list.h"	
+#include "array.h"
+#include "bytecode.h"
+#include "hashmap.h"
+#include "exprdag.h"
+#include "evaltable.h"
 
 
+/*Function prototypes*/
+
+static int Reads(const ast *exp, const intvar *var); /*Returns 1 if the expression contains the variable and 0 otherwise*/
+
+
+/*Function implementations*/
+
 /*Creates new variable of domainsize d*/
 
 intvar *NewVariable(int d) {
@@ -154,9 +166,12 @@ condition *NewCondition() {
 		exit(EXIT_FAILURE);
 	}
 	cond->exp = NewAst(EXP, EQ, NULL, 0, null0, null1);	/*0 == 0, true*/
+	cond->code = NULL;
+	cond->node = -1;
 	strcpy(cond->id, "");
 	cond->varlist = NULL;
 	cond->evallist = NULL;
+	cond->table = NULL;
 	cond->no_vars = 0;
 	return cond;
 } 
@@ -171,8 +186,10 @@ void DeleteCondition(void *cond) {
 	if (cond) {
 		c = (condition *) cond;
 		DeleteAst(c->exp);
+		DeleteBytecode(c->code);
 		DeleteList(&c->varlist, NULL);
 		DeleteList(&c->evallist, DeleteVector);	
+		DeleteEvaltable(c->table);
 		free(c);		
 	}
 }
@@ -190,6 +207,9 @@ assignment *NewAssignment() {
 	}
 	ass->var = NULL;
 	ass->exp = NULL;
+	ass->code = NULL;
+	ass->slot = -1;
+	ass->node = -1;
 	return ass;
 }
 
@@ -203,6 +223,7 @@ void DeleteAssignment(void *ass) {
 	if (ass) {
 		a = (assignment *) ass;	
 		DeleteAst(a->exp);	
+		DeleteBytecode(a->code);
 		free(a);
 	}
 }
@@ -234,6 +255,7 @@ action *NewAction(int v, int e) {
 	strcpy(act->id, "");
 	act->varlist = NULL;
 	act->assignments = NULL;
+	act->table = NULL;
 	act->no_vars = v;
 	act->no_evals = e;
 	return act;
@@ -251,6 +273,7 @@ void DeleteAction(void *act) {
 		a = (action *) act;
 		DeleteList(&a->varlist, NULL);
 		DeleteList(&a->assignments, DeleteAssignment);
+		DeleteEvaltable(a->table);
 		for(j = 0; j < 2; j++) {
 			for(i = 0; i < a->no_evals; i++) {
 				free(a->map[j][i]);				
@@ -278,6 +301,8 @@ transition *NewTransition() {
 	trans->loc[0] = NULL;
 	trans->loc[1] = NULL;			
 	trans->act = NULL;
+	trans->guard = NULL;
+	trans->effect = NULL;
 	return trans;
 } 
 
@@ -318,6 +343,10 @@ programgraph *NewPG() {
 	pg->no_vars = 0;
 	pg->no_acts = 0;
 	pg->no_trans = 0;	
+	pg->no_deadtrans = 0;
+	pg->no_deadlocs = 0;
+	pg->no_mergedlocs = 0;
+	pg->no_mergedtrans = 0;
 	return pg;
 } 
 
@@ -366,24 +395,18 @@ ast *CopyAst(const ast *exp) {
 
 /*Evaluates expression*/
 
-int Evaluate(const ast *exp, const list *varlist, const vector *vals) {
+int Evaluate(const ast *exp, const array *vars, const vector *vals) {
 
-	const list *node;
-	intvar *var;
-	int i = 0;
+	unsigned i;
   
   	if (exp) {
 	 	switch (exp->type) {
 	 		case VAR:
-	 			if (varlist) {
-					node = varlist;
-					do {
-						var = (intvar *) node->data;
-						if (var == exp->node.var) 							
+	 			if (vars) {
+					for (i = 0; i < vars->n; i++) {
+						if (vars->el[i] == exp->node.var) 							
 							return ((int *) vals->coord)[i];										
-						i++;
-						node = node->next;
-					} while (node != varlist);	
+					}
 				}	
 	 			break;
 			case NUM:
@@ -391,37 +414,37 @@ int Evaluate(const ast *exp, const list *varlist, const vector *vals) {
 				break;
 			default:
 				if (exp->node.op == PLUS) 
-					return Evaluate(exp->l, varlist, vals) + Evaluate(exp->r, varlist, vals);
+					return Evaluate(exp->l, vars, vals) + Evaluate(exp->r, vars, vals);
 				else if (exp->node.op == MINUS) {
 					if (exp->l)
-						return Evaluate(exp->l, varlist, vals) - Evaluate(exp->r, varlist, vals);
+						return Evaluate(exp->l, vars, vals) - Evaluate(exp->r, vars, vals);
 					else 
-						return - Evaluate(exp->r, varlist, vals);	
+						return - Evaluate(exp->r, vars, vals);	
 				}		
 				else if (exp->node.op == TIMES) 
-					return Evaluate(exp->l, varlist, vals) * Evaluate(exp->r, varlist, vals);	
+					return Evaluate(exp->l, vars, vals) * Evaluate(exp->r, vars, vals);	
 				else if (exp->node.op == DIV) 
-					return Evaluate(exp->l, varlist, vals) / Evaluate(exp->r, varlist, vals);	
+					return Evaluate(exp->l, vars, vals) / Evaluate(exp->r, vars, vals);	
 				else if (exp->node.op == MOD) 
-					return Evaluate(exp->l, varlist, vals) % Evaluate(exp->r, varlist, vals);	
+					return Evaluate(exp->l, vars, vals) % Evaluate(exp->r, vars, vals);	
 				else if (exp->node.op == EQ) 
-					return Evaluate(exp->l, varlist, vals) == Evaluate(exp->r, varlist, vals);
+					return Evaluate(exp->l, vars, vals) == Evaluate(exp->r, vars, vals);
 				else if (exp->node.op == NEQ) 
-					return Evaluate(exp->l, varlist, vals) != Evaluate(exp->r, varlist, vals);	
+					return Evaluate(exp->l, vars, vals) != Evaluate(exp->r, vars, vals);	
 				else if (exp->node.op == L) 
-					return Evaluate(exp->l, varlist, vals) < Evaluate(exp->r, varlist, vals);				
+					return Evaluate(exp->l, vars, vals) < Evaluate(exp->r, vars, vals);				
 				else if (exp->node.op == LEQ) 
-					return Evaluate(exp->l, varlist, vals) <= Evaluate(exp->r, varlist, vals);	
+					return Evaluate(exp->l, vars, vals) <= Evaluate(exp->r, vars, vals);	
 				else if (exp->node.op == G) 
-					return Evaluate(exp->l, varlist, vals) > Evaluate(exp->r, varlist, vals);	
+					return Evaluate(exp->l, vars, vals) > Evaluate(exp->r, vars, vals);	
 				else if (exp->node.op == GEQ) 
-					return Evaluate(exp->l, varlist, vals) >= Evaluate(exp->r, varlist, vals);									
+					return Evaluate(exp->l, vars, vals) >= Evaluate(exp->r, vars, vals);									
 				else if (exp->node.op == OR) 
-					return Evaluate(exp->l, varlist, vals) || Evaluate(exp->r, varlist, vals);
+					return Evaluate(exp->l, vars, vals) || Evaluate(exp->r, vars, vals);
 				else if (exp->node.op == AND) 
-					return Evaluate(exp->l, varlist, vals) && Evaluate(exp->r, varlist, vals);		
+					return Evaluate(exp->l, vars, vals) && Evaluate(exp->r, vars, vals);		
 				else 
-					return !Evaluate(exp->r, varlist, vals);	
+					return !Evaluate(exp->r, vars, vals);	
 				break;			 			
 	 	}
 	} 		 	
@@ -525,31 +548,28 @@ void ActionName(char *name, const action *act) {
 
 /*Returns 1 if vector satisfies condition and 0 otherwise*/
 
-int CheckCondition(const vector *vec, const condition *cond, const list *varlist) {
+int CheckCondition(const vector *vec, const condition *cond, const array *vars, exprdag *dag) {
 
 	int i, j, result = 0;
-	const list *clist, *vlist;
+	const list *clist;
 	const intvar *var, *va;
-	const int vars = NumberOfElements(varlist);
 	vector *v;
 	const vector *ev;
 
-	if (inp == OPTION_old) {
+	if (inp == OPTION_old && cond->table)
+		return ContainsEvaluation(cond->table, vec->coord);
+	else if (inp == OPTION_old) {
 		v = NewVector(cond->no_vars, sizeof(int));
 		if (cond->varlist) {
 			clist = cond->varlist;
 			for (i = 0; i < cond->no_vars; i++) {
 				var = (intvar *) clist->data;
-				if (varlist) {
-					vlist = varlist;
-					for (j = 0; j < vars; j++) {
-						va = (intvar *) vlist->data;
-						if (strcmp(var->id, va->id) == 0) {
-							((int *) v->coord)[i] = ((int *) vec->coord)[j];
-							break;		
-						}	
-						vlist = vlist->next;
-					}
+				for (j = 0; j < vec->dim; j++) {
+					va = (intvar *) vars->el[j];
+					if (strcmp(var->id, va->id) == 0) {
+						((int *) v->coord)[i] = ((int *) vec->coord)[j];
+						break;		
+					}	
 				}
 				clist = clist->next;
 			}
@@ -568,185 +588,45 @@ int CheckCondition(const vector *vec, const condition *cond, const list *varlist
 		DeleteVector(v);
 		return result;
 	}
+	else if (cond->code)
+		return RunBytecode(cond->code, vec->coord, dag);
 	else 		
-		return Evaluate(cond->exp, varlist, vec);		
-}
-
-
-/*Merges conditions*/
-
-condition *MergeConditions(const condition *cond1, const condition *cond2) { /*only needed when inp == OPTION_old*/
-
-	condition *cond = NewCondition();
-	int i, j, index[cond2->no_vars], *evc, *ev2c;
-	const list *vlist, *wlist;
-	const intvar *var, *va;
-	const vector *ev1, *ev2;
-	vector *ev;
-	
-	ConcatLists(&cond->varlist, cond1->varlist);
-	MergeLists(&cond->varlist, cond2->varlist, NULL);
-	cond->no_vars = NumberOfElements(cond->varlist);
-	strcpy(cond->id, "merged");
-	if (cond2->varlist) {
-		vlist = cond2->varlist;
-		for (i = 0; i < cond2->no_vars; i++) {				
-			var = (intvar *) vlist->data;
-			wlist = cond->varlist;
-			for (j = 0; j < cond->no_vars; j++) {							
-				va = (intvar *) wlist->data;
-				if (strcmp(var->id, va->id) == 0) {
-					index[i] = j;
-					break;
-				}
-				wlist = wlist->next;				
-			}
-			vlist = vlist->next;			
-		}
-	}
-	if (cond1->evallist) {
-		vlist = cond1->evallist;
-		do {
-			ev1 = (vector *) vlist->data;				
-			if (cond2->evallist) {
-				wlist = cond2->evallist;
-				do {
-					ev2 = (vector *) wlist->data;
-					ev2c = ev2->coord;
-					ev = NewVector(cond->no_vars, sizeof(int));
-					evc = ev->coord;
-					for (i = 0; i < cond1->no_vars; i++) 	
-						evc[i] = ((int *) ev1->coord)[i];
-					for (i = 0; i < cond2->no_vars; i++) {
-						if (index[i] < cond1->no_vars && evc[index[i]] != ev2c[i]) {
-							DeleteVector(ev);
-							ev = NULL;
-							break;
-						}
-						evc[index[i]] = ev2c[i];
-					}
-					if (ev)
-						cond->evallist = InsertElement(ev, cond->evallist);
-					wlist = wlist->next;
-				} while (wlist != cond2->evallist);
-			}
-			vlist = vlist->next;
-		} while (vlist != cond1->evallist);
-	}
-	return cond;
+		return Evaluate(cond->exp, vars, vec);		
 }
 
 
-/*Extends condition cond to larger list of variables varlist, result is in newcond*/
-
-void ExtendCondition(const condition *cond, condition *newcond, const list *varlist) { /*only needed when inp == OPTION_old*/
-
-	int i, deletedata = 0;	
-	const intvar *var, *var2;
-	const list *vlist, *vlist2;
-	list *helpvarlist = NULL, *helpevallist = NULL, *veclist, *product, *transpose;
-	vector *vec;
-			
-	strcpy(newcond->id, cond->id);
-	newcond->no_vars = NumberOfElements(varlist);
-	DeleteList(&newcond->varlist, NULL);
-	ConcatLists(&newcond->varlist, varlist);
-	DeleteList(&newcond->evallist, NULL);
-	if (cond->evallist) { 
-		if (!varlist) /*in this case, cond->varlist should be NULL, too*/
-			ConcatLists(&newcond->evallist, cond->evallist);
-		else { 
-			ConcatLists(&helpvarlist, cond->varlist);
-			MergeLists(&helpvarlist, varlist, NULL);
-			ConcatLists(&helpevallist, cond->evallist);			
-			if (newcond->no_vars != cond->no_vars) {
-				vlist = helpvarlist;
-				for (i = 0; i < cond->no_vars; i++)
-					vlist = vlist->next;				
-				do {
-					var = (intvar *) vlist->data;
-					veclist = NULL;
-					for (i = 0; i < var->domain->dim; i++) {
-						vec = NewVector(1, sizeof(int));
-						((int *) vec->coord)[0] = ((int *) var->domain->coord)[i];
-						veclist = InsertElement(vec, veclist);	
-					}
-					product = Product(helpevallist, veclist, INT);
-					if (deletedata)
-						DeleteList(&helpevallist, DeleteVector); 						
-					else {
-						DeleteList(&helpevallist, NULL);
-						deletedata = 1;
-					}
-					DeleteList(&veclist, DeleteVector);
-					helpevallist = product;
-					vlist = vlist->next;			
-				} while (vlist != helpvarlist);
-			}								
-			transpose = Transpose(helpevallist);
-			if (deletedata) 
-				DeleteList(&helpevallist, DeleteVector);
-			else 
-				DeleteList(&helpevallist, NULL);
-			helpevallist = transpose;	
-			vlist = varlist;
-			do {
-				var = (intvar *) vlist->data;
-				vlist2 = helpvarlist;
-				veclist = helpevallist;
-				do {
-					var2 = (intvar *) vlist2->data;
-					vec = (vector *) veclist->data;
-					if (var == var2) {
-						newcond->evallist = InsertElement(vec, newcond->evallist);
-						break;
-					}
-					veclist = veclist->next;
-					vlist2 = vlist2->next;
-				} while (vlist2 != helpvarlist);
-				vlist = vlist->next;
-			} while (vlist != varlist);
-			transpose = Transpose(newcond->evallist);
-			DeleteList(&newcond->evallist, NULL);
-			newcond->evallist = transpose;
-			DeleteList(&helpevallist, DeleteVector);
-			DeleteList(&helpvarlist, NULL);
-		}
-	}
-} 
-
-
 /*Computes the effect of the action on invec, result is in outvec*/ 
 
-void Effect(const action *act, const vector *invec, vector *outvec, const list *varlist) {
+void Effect(const action *act, const vector *invec, vector *outvec, const array *vars, exprdag *dag) {
 	
-	const int novars = NumberOfElements(varlist);
-	int i, j, k, ind[novars], arg[act->no_vars]; 
-	const list *vlist1, *vlist2, *node;
-	const intvar *var1, *var2;
+	const int novars = invec->dim;
+	int i, j, k, ind[novars > 0 ? novars : 1], arg[act->no_vars > 0 ? act->no_vars : 1]; 
+	const list *vlist2, *node;
 	assignment *ass;
 	
-	if (inp == OPTION_old) {
-		if (varlist && act->varlist) {
-			i = 0;
-			vlist1 = varlist;
-			do {
-				var1 = (intvar *) vlist1->data;
-				ind[i] = -1;
+	if (inp == OPTION_old && act->table) {
+		for (i = 0; i < novars; i++)
+			((int *) outvec->coord)[i] = ((int *) invec->coord)[i];
+/*the values are not changed if the effect is not defined for them*/
+		if ((k = FindEvaluation(act->table, invec->coord)) >= 0)
+			for (j = 0; j < act->no_vars; j++)
+				((int *) outvec->coord)[act->table->slot[j]] = act->map[1][k][j];
+	}
+	else if (inp == OPTION_old) {
+		for (i = 0; i < novars; i++) {
+			ind[i] = -1;
+			if (act->varlist) {
 				j = 0;	
 				vlist2 = act->varlist;
 				do {
-					var2 = (intvar *) vlist2->data;
-					if (var1 == var2) {
+					if (vars->el[i] == vlist2->data) {
 						ind[i] = j;
 						break;
 					}
 					j = j + 1;
 					vlist2 = vlist2->next;
 				} while (vlist2 != act->varlist);
-				i = i + 1;
-				vlist1 = vlist1->next;
-			} while (vlist1 != varlist);	
+			}
 		}
 		for (i = 0; i < novars; i++) { 
 			if (ind[i] >= 0)
@@ -775,20 +655,276 @@ void Effect(const action *act, const vector *invec, vector *outvec, const list *
 			node = act->assignments;
 			do {
 				ass = (assignment *) node->data;				
-				if (varlist) {
-					i = 0;
-					vlist1 = varlist;
-					do {
-						var1 = (intvar *) vlist1->data;
-						if (var1 == ass->var)
-							break;
-						i++;	
-						vlist1 = vlist1->next;
-					} while (vlist1 != varlist);
-				}										
-				((int *) outvec->coord)[i] = Evaluate(ass->exp, varlist, outvec);				
+/*the assignments compiled with caching read no variable assigned before, on which outvec and invec agree*/
+				if (ass->code)
+					((int *) outvec->coord)[ass->slot] = RunBytecode(ass->code, outvec->coord, dag);
+				else {
+					for (i = 0; vars->el[i] != ass->var; i++)
+						;										
+					((int *) outvec->coord)[i] = Evaluate(ass->exp, vars, outvec);
+				}				
 				node = node->next;
 			} while (node != act->assignments);
 		}
 	}	
 } 	
+
+
+/*Enters the guards and the assignments of the program graph in dag, except the assignments reading a variable assigned before in the same action*/
+
+void EnterPG(programgraph *pg, const array *vars, exprdag *dag) {
+
+	const list *tlist, *alist, *prev;
+	transition *trans;
+	assignment *ass;
+	unsigned i;
+	int shared;
+
+	if (pg->translist) {
+		tlist = pg->translist;
+		do {
+			trans = (transition *) tlist->data;
+			if (trans->cond->node < 0)
+				trans->cond->node = AddToExprdag(dag, trans->cond->exp, vars);
+			if (trans->act && trans->act->assignments) {
+				alist = trans->act->assignments;
+				do {
+					ass = (assignment *) alist->data;
+					for (i = 0; i < vars->n && vars->el[i] != ass->var; i++)
+						;
+/*the value of the expression is shared only if the expression is evaluated on the values of the state*/
+					for (shared = 1, prev = trans->act->assignments; prev != alist && shared; prev = prev->next)
+						shared = !Reads(ass->exp, ((assignment *) prev->data)->var);
+					if (i < vars->n && ass->node < 0 && shared)
+						ass->node = AddToExprdag(dag, ass->exp, vars);
+					alist = alist->next;
+				} while (alist != trans->act->assignments);
+			}
+			tlist = tlist->next;
+		} while (tlist != pg->translist);
+	}
+}
+
+
+/*Compiles the guards, the final condition and the assignments of the program graph into bytecode over the variables in vars, the guards and assignments entered in dag by EnterPG() cache the values of their shared subexpressions*/
+
+void CompilePG(programgraph *pg, const array *vars, const exprdag *dag) {
+
+	const list *tlist, *alist;
+	transition *trans;
+	assignment *ass;
+	unsigned i;
+
+	if (!pg->cond_1->code)
+		pg->cond_1->code = CompileAst(pg->cond_1->exp, vars, NULL);
+	if (pg->translist) {
+		tlist = pg->translist;
+		do {
+			trans = (transition *) tlist->data;
+			if (!trans->cond->code)
+				trans->cond->code = CompileAst(trans->cond->exp, vars, trans->cond->node >= 0 ? dag : NULL);
+			if (trans->act && trans->act->assignments) {
+				alist = trans->act->assignments;
+				do {
+					ass = (assignment *) alist->data;
+					for (i = 0; i < vars->n && vars->el[i] != ass->var; i++)
+						;
+/*the assignment is compiled only if its variable is in vars*/
+					if (!ass->code && i < vars->n) {
+						ass->slot = i;
+						ass->code = CompileAst(ass->exp, vars, ass->node >= 0 ? dag : NULL);
+					}
+					alist = alist->next;
+				} while (alist != trans->act->assignments);
+			}
+			tlist = tlist->next;
+		} while (tlist != pg->translist);
+	}
+}
+
+
+/*Tabulates the evaluations of the guards, the final condition and the actions of the program graph given in the input format of the first versions (--old) over the variables in vars*/
+
+void TabulatePG(programgraph *pg, const array *vars) {
+
+	const list *tlist;
+	transition *trans;
+
+	if (!pg->cond_1->table)
+		pg->cond_1->table = TabulateCondition(pg->cond_1, vars);
+	if (pg->translist) {
+		tlist = pg->translist;
+		do {
+			trans = (transition *) tlist->data;
+			if (!trans->cond->table)
+				trans->cond->table = TabulateCondition(trans->cond, vars);
+			if (trans->act && !trans->act->table)
+				trans->act->table = TabulateAction(trans->act, vars);
+			tlist = tlist->next;
+		} while (tlist != pg->translist);
+	}
+}
+
+
+/*Replaces the constant arithmetic subexpressions (type NUMEXP) of the expression by numbers*/
+
+void SimplifyAst(ast *exp) {
+
+	int val;
+
+	if (exp) {
+		SimplifyAst(exp->l);
+		SimplifyAst(exp->r);
+		if (exp->type == NUMEXP && FoldAst(exp, &val)) {
+			DeleteAst(exp->l);
+			DeleteAst(exp->r);
+			exp->l = exp->r = NULL;
+			exp->type = NUM;
+			exp->node.num = val;
+			exp->par = 0;
+		}
+	}
+}
+
+
+/*Returns 1 and stores the value of the expression in val if the expression is constant, returns 0 otherwise, a division by zero is not folded*/
+
+int FoldAst(const ast *exp, int *val) {
+
+	int l, r, lc, rc;
+
+	if (!exp)
+		return 0;
+	if (exp->type == NUM) {
+		*val = exp->node.num;
+		return 1;
+	}
+	if (exp->type == VAR) 
+		return 0;
+	lc = exp->l && FoldAst(exp->l, &l);
+	if (exp->node.op == AND && lc && !l) {
+		*val = 0;
+		return 1;
+	}
+	if (exp->node.op == OR && lc && l) {
+		*val = 1;
+		return 1;
+	}
+	rc = FoldAst(exp->r, &r);
+	if (!rc || (!lc && exp->l) || (!exp->l && exp->node.op != MINUS && exp->node.op != NOT))
+		return 0;
+/*division by zero is left to run time, where it happens only if the expression is evaluated*/
+	if ((exp->node.op == DIV || exp->node.op == MOD) && r == 0)
+		return 0;
+	*val = Evaluate(exp, NULL, NULL);
+	return 1;
+}
+
+
+/*Returns 1 if the expression contains the variable and 0 otherwise*/
+
+static int Reads(const ast *exp, const intvar *var) {
+
+	if (!exp)
+		return 0;
+	if (exp->type == VAR)
+		return exp->node.var == var;
+	return Reads(exp->l, var) || Reads(exp->r, var);
+}
+
+
+/*Removes the transition from pg and its locations and deletes it*/
+
+void RemoveTransition(programgraph *pg, transition *trans) {
+
+	RemoveElement(&pg->translist, trans);
+	if (trans->loc[0])
+		RemoveElement(&trans->loc[0]->outtranslist, trans);
+	if (trans->loc[1])
+		RemoveElement(&trans->loc[1]->intranslist, trans);
+	DeleteTransition(trans);
+	pg->no_trans--;
+}
+
+
+/*Folds the constant arithmetic in the expressions of pg, removes the transitions whose guards are constant and never satisfied as well as the locations (except the final one) that are not reachable from the initial location*/
+
+void PrunePG(programgraph *pg) {
+
+	const list *tlist, *alist;
+	list *dead = NULL, *llist;
+	transition *trans;
+	location *loc;
+	hashmap *reached;
+	array *queue;
+	unsigned q;
+	int val;
+
+	SimplifyAst(pg->cond_0->exp);
+	SimplifyAst(pg->cond_1->exp);
+	if (pg->translist) {
+		tlist = pg->translist;
+		do {
+			trans = (transition *) tlist->data;
+			SimplifyAst(trans->cond->exp);
+			if (trans->act && (alist = trans->act->assignments)) {
+				do {
+					SimplifyAst(((assignment *) alist->data)->exp);
+					alist = alist->next;
+				} while (alist != trans->act->assignments);
+			}
+			if (FoldAst(trans->cond->exp, &val) && val != 1)
+				dead = InsertElement(trans, dead);
+			tlist = tlist->next;
+		} while (tlist != pg->translist);
+	}
+	while (dead) {
+		RemoveTransition(pg, (transition *) dead->data);
+		pg->no_deadtrans++;
+		Pop(&dead, NULL);
+	}
+	if (!pg->loc_0)
+		return;
+/*locations reachable from the initial location*/
+	reached = NewHashmap(PTR);
+	queue = NewArray();
+	AddToHashmap(reached, pg->loc_0, NULL);
+	AppendToArray(queue, pg->loc_0);
+	for (q = 0; q < queue->n; q++) {
+		loc = (location *) queue->el[q];
+		if ((tlist = loc->outtranslist)) {
+			do {
+				trans = (transition *) tlist->data;
+				if (trans->loc[1] && AddToHashmap(reached, trans->loc[1], NULL))
+					AppendToArray(queue, trans->loc[1]);
+				tlist = tlist->next;
+			} while (tlist != loc->outtranslist);
+		}
+	}
+	if ((llist = pg->loclist)) {
+		do {
+			loc = (location *) llist->data;
+			if (loc != pg->loc_1 && !IsKey(reached, loc))
+				dead = InsertElement(loc, dead);
+			llist = llist->next;
+		} while (llist != pg->loclist);
+	}
+	if ((llist = dead)) {
+		do {
+			loc = (location *) llist->data;
+			while (loc->outtranslist) {
+				RemoveTransition(pg, (transition *) loc->outtranslist->data);
+				pg->no_deadtrans++;
+			}
+			llist = llist->next;
+		} while (llist != dead);
+	}
+	while (dead) {
+		RemoveElement(&pg->loclist, dead->data);
+		DeleteLocation(dead->data);
+		pg->no_deadlocs++;
+		Pop(&dead, NULL);
+	}
+	DeleteArray(queue, NULL);
+	DeleteHashmap(reached, NULL);
+}
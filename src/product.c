@@ -0,0 +1,85 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File product.c
+
+This file implements the functions declared in product.h.
+************************************************************************************************/
+
+#include "product.h"
+
+
+/*Function implementations*/
+
+/*Initializes it for the product of k factors of sizes n[0],..., n[k-1], the index tuples are stored in the caller's array idx of length k*/
+
+void InitProductiter(productiter *it, int k, const int n[], int idx[], int (*accept)(const int [], int, void *), void *data) {
+
+	it->k = k;
+	it->n = n;
+	it->idx = idx;
+	it->accept = accept;
+	it->data = data;
+	it->state = 0;
+}
+
+
+/*Sets it->idx to the next index tuple all of whose prefixes are accepted and returns 1, returns 0 if there is no further tuple*/
+
+int NextTuple(productiter *it) {
+
+	int i;
+
+	if (it->state == 2)
+		return 0;
+	if (it->k == 0) {
+/*the product of no factors has exactly one (empty) tuple*/
+		it->state = it->state == 0 ? 1 : 2;
+		return it->state == 1;
+	}
+	if (it->state == 0) {
+		it->state = 1;
+		i = 0;
+		it->idx[0] = 0;
+	}
+	else {
+		i = it->k - 1;
+		it->idx[i]++;
+	}
+/*depth-first search, i is the position whose index has just been set*/
+	while (i >= 0) {
+		if (it->idx[i] == it->n[i]) {
+			if (--i >= 0)
+				it->idx[i]++;
+		}
+		else if (it->accept && !it->accept(it->idx, i + 1, it->data)) 
+			it->idx[i]++;
+		else if (i == it->k - 1) 
+			return 1;
+		else 
+			it->idx[++i] = 0;
+	}
+	it->state = 2;
+	return 0;
+}
@@ -0,0 +1,552 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File symbolic.c
+
+This file implements the function declared in symbolic.h.
+************************************************************************************************/
+
+#include "symbolic.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include "def.h"
+#include "vector.h"
+#include "list.h"
+#include "array.h"
+#include "hashmap.h"
+#include "pgraph.h"
+#include "cube.h"
+#include "hda.h"
+#include "mdd.h"
+
+
+/*Transition group: a transition of a program graph or, if trans is NULL, the final condition of the system*/
+
+typedef struct group group;
+
+struct group {
+	const transition *trans;	/*transition*/
+	int pid;	/*process of the transition*/
+	int k;	/*number of levels of the support*/
+	int *support;	/*levels of the states read or written by the transition, increasing*/
+	int *pos;	/*pos[l] is the position of level l in the support, -1 if l is not in the support*/
+	mdd *proj;	/*MDD of the projections of states to the support*/
+	int seen, enabled;	/*nodes of proj: projections already evaluated, projections at which the transition is enabled (or the system is final)*/
+	mdd *rel;	/*MDD of the relation, whose levels 2j and 2j+1 are the values of support level j before and after the transition*/
+	int relation;	/*node of rel*/
+};
+
+/*Data for learning the relations from the projections of states*/
+
+typedef struct learner learner;
+
+struct learner {
+	group *g;	/*group learning*/
+	const vector *pgvec;	/*program graphs*/
+	const array *vars;	/*variables*/
+	vector *in, *out;	/*valuations of the variables before and after the transition*/
+	array *rows, *enabled;	/*new rows of the relation and of the enabled projections*/
+};
+
+/*Pair of a digit and a node*/
+
+typedef struct branch branch;
+
+struct branch {
+	int digit, node;
+};
+
+
+/*Function prototypes*/
+
+static void MarkAst(const ast *exp, const array *vars, int pgs, char *mark); /*Marks the levels of the variables of the expression*/
+static void MarkVariables(const list *varlist, int n, const array *vars, int pgs, char *mark); /*Marks the levels of the first n variables of varlist (--old), which are matched by name*/
+static group *NewGroup(const transition *trans, int pid, const vector *pgvec, const array *vars); /*Creates the transition group of the transition of process pid, or of the final condition of the system if trans is NULL*/
+static void DeleteGroup(void *g); /*Deletes given transition group*/
+static int Project(group *g, const mdd *sm, int s, int l, hashmap *memo); /*Returns the node of g->proj of the projection to the support of the set of states of node s of level l*/
+static int BranchCmp(const void *p, const void *q); /*Compares branches by digit for qsort*/
+static int Image(const group *g, mdd *sm, int s, int r, int l, hashmap *memo); /*Returns the node of the states reached by the transition of g from the states of node s of level l, whose relation from level l on is node r of g->rel*/
+static int Restrict(const group *g, mdd *sm, int s, int e, int l, hashmap *memo); /*Returns the node of the states of node s of level l whose projection (from level l on) belongs to node e of g->proj*/
+static int LearnProjection(const int digit[], void *data); /*Evaluates the transition of a group at a projection and records the rows of the relation, returns 1*/
+static void Learn(learner *lr, group *g, const mdd *sm, int s); /*Extends the relation of g to the projections of the states of node s*/
+static int Memo(hashmap *memo, int a, int b, int *result); /*Looks up the pair (a, b) in memo and stores the result in result, returns 1 if found and 0 otherwise*/
+static void Remember(hashmap *memo, int a, int b, int result); /*Enters the result for the pair (a, b) in memo*/
+
+
+/*Function implementations*/
+
+/*Marks the levels of the variables of the expression*/
+
+static void MarkAst(const ast *exp, const array *vars, int pgs, char *mark) {
+
+	unsigned i;
+
+	if (exp) {
+		if (exp->type == VAR) {
+			for (i = 0; i < vars->n; i++)
+				if (vars->el[i] == exp->node.var)
+					mark[pgs + i] = 1;
+		}
+		MarkAst(exp->l, vars, pgs, mark);
+		MarkAst(exp->r, vars, pgs, mark);
+	}
+}
+
+
+/*Marks the levels of the first n variables of varlist (--old), which are matched by name*/
+
+static void MarkVariables(const list *varlist, int n, const array *vars, int pgs, char *mark) {
+
+	const list *node = varlist;
+	unsigned i;
+	int j;
+
+	for (j = 0; j < n && node; j++, node = node->next) {
+		for (i = 0; i < vars->n; i++)
+			if (strcmp(((intvar *) node->data)->id, ((intvar *) vars->el[i])->id) == 0)
+				mark[pgs + i] = 1;
+	}
+}
+
+
+/*Creates the transition group of the transition of process pid, or of the final condition of the system if trans is NULL*/
+
+static group *NewGroup(const transition *trans, int pid, const vector *pgvec, const array *vars) {
+
+	const programgraph *const *const pg = pgvec->coord;
+	const int levels = pgvec->dim + vars->n;
+	int radix[2 * levels], l, i;
+	char mark[levels];
+	const list *node;
+	group *g;
+
+	memset(mark, 0, sizeof(char) * levels);
+	if (trans) {
+		mark[pid] = 1;
+		if (inp == OPTION_old) {
+			MarkVariables(trans->cond->varlist, trans->cond->no_vars, vars, pgvec->dim, mark);
+			if (trans->act)
+				MarkVariables(trans->act->varlist, trans->act->no_vars, vars, pgvec->dim, mark);
+		}
+		else {
+			MarkAst(trans->cond->exp, vars, pgvec->dim, mark);
+			if (trans->act && trans->act->assignments) {
+				node = trans->act->assignments;
+				do {
+					for (i = 0; i < (int) vars->n; i++)
+						if (vars->el[i] == ((assignment *) node->data)->var)
+							mark[pgvec->dim + i] = 1;
+					MarkAst(((assignment *) node->data)->exp, vars, pgvec->dim, mark);
+					node = node->next;
+				} while (node != trans->act->assignments);
+			}
+		}
+	}
+	else {
+		for (i = 0; i < pgvec->dim; i++) {
+			mark[i] = 1;
+			if (inp == OPTION_old)
+				MarkVariables(pg[i]->cond_1->varlist, pg[i]->cond_1->no_vars, vars, pgvec->dim, mark);
+			else
+				MarkAst(pg[i]->cond_1->exp, vars, pgvec->dim, mark);
+		}
+	}
+	if ((g = malloc(sizeof(group))) == NULL || (g->support = malloc(sizeof(int) * levels)) == NULL || (g->pos = malloc(sizeof(int) * levels)) == NULL) {
+		printf("NewGroup: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	g->trans = trans;
+	g->pid = pid;
+	g->k = 0;
+	for (l = 0; l < levels; l++) {
+		g->pos[l] = mark[l] ? g->k : -1;
+		if (mark[l])
+			g->support[g->k++] = l;
+	}
+	for (l = 0; l < 2 * g->k; l++)
+		radix[l] = MDD_UNBOUNDED;
+	g->proj = NewMdd(g->k, radix);
+	g->rel = NewMdd(2 * g->k, radix);
+	g->seen = g->enabled = g->relation = MDD_FALSE;
+	return g;
+}
+
+
+/*Deletes given transition group*/
+
+static void DeleteGroup(void *g) {
+
+	group *gr = g;
+
+	if (gr) {
+		DeleteMdd(gr->proj);
+		DeleteMdd(gr->rel);
+		free(gr->support);
+		free(gr->pos);
+		free(gr);
+	}
+}
+
+
+/*Looks up the pair (a, b) in memo and stores the result in result, returns 1 if found and 0 otherwise*/
+
+static int Memo(hashmap *memo, int a, int b, int *result) {
+
+	int keycoord[2] = {a, b};
+	vector key = {2, keycoord};
+	void *r;
+
+	if ((r = LookupKey(memo, &key))) {
+		*result = (int) (uintptr_t) r - 1;
+		return 1;
+	}
+	return 0;
+}
+
+
+/*Enters the result for the pair (a, b) in memo*/
+
+static void Remember(hashmap *memo, int a, int b, int result) {
+
+	vector *key = NewVector(2, sizeof(int));
+
+	((int *) key->coord)[0] = a;
+	((int *) key->coord)[1] = b;
+	AddToHashmap(memo, key, (void *) (uintptr_t) (result + 1));
+}
+
+
+/*Returns the node of g->proj of the projection to the support of the set of states of node s of level l*/
+
+static int Project(group *g, const mdd *sm, int s, int l, hashmap *memo) {
+
+	int r, j, *digit, *child;
+
+	if (s == MDD_FALSE)
+		return MDD_FALSE;
+	if (l > g->support[g->k - 1])
+		return MDD_TRUE;
+	if (Memo(memo, s, 0, &r))
+		return r;
+	if (g->pos[l] < 0) {
+		for (r = MDD_FALSE, j = 0; j < sm->arity[s]; j++)
+			r = MddOr(g->proj, r, Project(g, sm, sm->child[s][j], l + 1, memo));
+	}
+	else {
+		if ((digit = malloc(sizeof(int) * sm->arity[s])) == NULL || (child = malloc(sizeof(int) * sm->arity[s])) == NULL) {
+			printf("Project: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (j = 0; j < sm->arity[s]; j++) {
+			digit[j] = sm->digit[s][j];
+			child[j] = Project(g, sm, sm->child[s][j], l + 1, memo);
+		}
+		r = MddSparseNode(g->proj, g->pos[l], sm->arity[s], digit, child);
+		free(digit);
+		free(child);
+	}
+	Remember(memo, s, 0, r);
+	return r;
+}
+
+
+/*Compares branches by digit for qsort*/
+
+static int BranchCmp(const void *p, const void *q) {
+
+	const branch *a = p, *b = q;
+
+	return (a->digit > b->digit) - (a->digit < b->digit);
+}
+
+
+/*Returns the node of the states reached by the transition of g from the states of node s of level l, whose relation from level l on is node r of g->rel*/
+
+static int Image(const group *g, mdd *sm, int s, int r, int l, hashmap *memo) {
+
+	int res, i, j, n, before, *digit, *child;
+	branch *br;
+
+	if (s == MDD_FALSE || r == MDD_FALSE)
+		return MDD_FALSE;
+	if (l > g->support[g->k - 1])
+		return s;
+	if (Memo(memo, s, r, &res))
+		return res;
+	if (g->pos[l] < 0) {
+		if ((digit = malloc(sizeof(int) * sm->arity[s])) == NULL || (child = malloc(sizeof(int) * sm->arity[s])) == NULL) {
+			printf("Image: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (j = 0; j < sm->arity[s]; j++) {
+			digit[j] = sm->digit[s][j];
+			child[j] = Image(g, sm, sm->child[s][j], r, l + 1, memo);
+		}
+		res = MddSparseNode(sm, l, sm->arity[s], digit, child);
+		free(digit);
+		free(child);
+	}
+	else {
+/*the branches for the values after the transition, sorted and merged*/
+		for (n = j = 0; j < sm->arity[s]; j++)
+			if ((before = MddChild(g->rel, r, 2 * g->pos[l], sm->digit[s][j])) != MDD_FALSE)
+				n += g->rel->arity[before];
+		if ((br = malloc(sizeof(branch) * (n > 0 ? n : 1))) == NULL || (digit = malloc(sizeof(int) * (n > 0 ? n : 1))) == NULL || (child = malloc(sizeof(int) * (n > 0 ? n : 1))) == NULL) {
+			printf("Image: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (n = j = 0; j < sm->arity[s]; j++) {
+			if ((before = MddChild(g->rel, r, 2 * g->pos[l], sm->digit[s][j])) == MDD_FALSE)
+				continue;
+			for (i = 0; i < g->rel->arity[before]; i++) {
+				br[n].digit = g->rel->digit[before][i];
+				br[n++].node = Image(g, sm, sm->child[s][j], g->rel->child[before][i], l + 1, memo);
+			}
+		}
+		qsort(br, n, sizeof(branch), BranchCmp);
+		for (i = j = 0; i < n; i++) {
+			if (j > 0 && digit[j - 1] == br[i].digit)
+				child[j - 1] = MddOr(sm, child[j - 1], br[i].node);
+			else {
+				digit[j] = br[i].digit;
+				child[j++] = br[i].node;
+			}
+		}
+		res = MddSparseNode(sm, l, j, digit, child);
+		free(br);
+		free(digit);
+		free(child);
+	}
+	Remember(memo, s, r, res);
+	return res;
+}
+
+
+/*Returns the node of the states of node s of level l whose projection (from level l on) belongs to node e of g->proj*/
+
+static int Restrict(const group *g, mdd *sm, int s, int e, int l, hashmap *memo) {
+
+	int res, j, *digit, *child;
+
+	if (s == MDD_FALSE || e == MDD_FALSE)
+		return MDD_FALSE;
+	if (l > g->support[g->k - 1])
+		return s;
+	if (Memo(memo, s, e, &res))
+		return res;
+	if ((digit = malloc(sizeof(int) * sm->arity[s])) == NULL || (child = malloc(sizeof(int) * sm->arity[s])) == NULL) {
+		printf("Restrict: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	for (j = 0; j < sm->arity[s]; j++) {
+		digit[j] = sm->digit[s][j];
+		child[j] = Restrict(g, sm, sm->child[s][j], g->pos[l] < 0 ? e : MddChild(g->proj, e, g->pos[l], digit[j]), l + 1, memo);
+	}
+	res = MddSparseNode(sm, l, sm->arity[s], digit, child);
+	free(digit);
+	free(child);
+	Remember(memo, s, e, res);
+	return res;
+}
+
+
+/*Evaluates the transition of a group at a projection and records the rows of the relation, returns 1*/
+
+static int LearnProjection(const int digit[], void *data) {
+
+	learner *lr = data;
+	const group *g = lr->g;
+	const programgraph *const *const pg = lr->pgvec->coord;
+	const int pgs = lr->pgvec->dim;
+	int *in = lr->in->coord, *out = lr->out->coord, *row, j, l, enabled = 1;
+
+	for (j = 0; j < g->k; j++)
+		if (g->support[j] >= pgs)
+			in[g->support[j] - pgs] = digit[j];
+	if (g->trans) {
+		enabled = digit[g->pos[g->pid]] == g->trans->loc[0]->index
+			&& (g->trans->guard ? g->trans->guard(in) : CheckCondition(lr->in, g->trans->cond, lr->vars, NULL)) == 1;
+	}
+	else {
+		for (j = 0; j < pgs && enabled; j++)
+			enabled = pg[j]->loc_1 && digit[g->pos[j]] == pg[j]->loc_1->index && CheckCondition(lr->in, pg[j]->cond_1, lr->vars, NULL) == 1;
+	}
+	if (!enabled)
+		return 1;
+	if ((row = malloc(sizeof(int) * (g->k > 0 ? g->k : 1))) == NULL) {
+		printf("LearnProjection: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+	memcpy(row, digit, sizeof(int) * g->k);
+	AppendToArray(lr->enabled, row);
+	if (g->trans) {
+		if (g->trans->effect)
+			g->trans->effect(in, out);
+		else
+			Effect(g->trans->act, lr->in, lr->out, lr->vars, NULL);
+		if ((row = malloc(sizeof(int) * 2 * g->k)) == NULL) {
+			printf("LearnProjection: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (j = 0; j < g->k; j++) {
+			l = g->support[j];
+			row[2 * j] = digit[j];
+			row[2 * j + 1] = l == g->pid ? g->trans->loc[1]->index : (l >= pgs ? out[l - pgs] : digit[j]);
+		}
+		AppendToArray(lr->rows, row);
+	}
+	return 1;
+}
+
+
+/*Extends the relation of g to the projections of the states of node s*/
+
+static void Learn(learner *lr, group *g, const mdd *sm, int s) {
+
+	int lev[2 * g->k], l, new;
+	hashmap *memo = NewHashmap(INT);
+
+	new = MddMinus(g->proj, Project(g, sm, s, 0, memo), g->seen);
+	DeleteHashmap(memo, DeleteVector);
+	if (new == MDD_FALSE)
+		return;
+	g->seen = MddOr(g->proj, g->seen, new);
+	lr->g = g;
+	MddEnumerate(g->proj, new, LearnProjection, lr);
+	for (l = 0; l < 2 * g->k; l++)
+		lev[l] = l;
+	g->enabled = MddOr(g->proj, g->enabled, MddFromRows(g->proj, lev, g->k, (int **) lr->enabled->el, lr->enabled->n));
+	if (g->trans)
+		g->relation = MddOr(g->rel, g->relation, MddFromRows(g->rel, lev, 2 * g->k, (int **) lr->rows->el, lr->rows->n));
+	ClearArray(lr->enabled, free);
+	ClearArray(lr->rows, free);
+}
+
+
+/*Computes and prints the numbers of states, edges and deadlocks of the HDA of the system of program graphs in pgvec over the variables in vars*/
+
+void SymbolicCount(const vector *pgvec, const array *vars) {
+
+	const programgraph *const *const pg = pgvec->coord;
+	const int pgs = pgvec->dim, levels = pgvec->dim + vars->n;
+	int radix[levels > 0 ? levels : 1], lev[levels > 0 ? levels : 1], *row, l, i, reach, frontier, next, enabled, final, iterations = 0;
+	unsigned q;
+	uint64_t edges = 0, states, deadlocks;
+	const list *tlist;
+	const state *st;
+	array *groups = NewArray(), *init, *rows = NewArray();
+	group *g, *fin;
+	hashmap *memo;
+	mdd *sm;
+	learner lr = {NULL, pgvec, vars, NewVector(vars->n, sizeof(int)), NewVector(vars->n, sizeof(int)), NewArray(), NewArray()};
+
+	for (l = 0; l < levels; l++) {
+		radix[l] = MDD_UNBOUNDED;
+		lev[l] = l;
+	}
+	sm = NewMdd(levels, radix);
+	for (i = 0; i < pgs; i++) {
+		if (pg[i]->translist) {
+			tlist = pg[i]->translist;
+			do {
+				AppendToArray(groups, NewGroup((transition *) tlist->data, i, pgvec, vars));
+				tlist = tlist->next;
+			} while (tlist != pg[i]->translist);
+		}
+	}
+	fin = NewGroup(NULL, -1, pgvec, vars);
+/*initial states*/
+	init = InitialStates(pgvec, vars);
+	for (q = 0; q < init->n; q++) {
+		st = init->el[q];
+		if ((row = malloc(sizeof(int) * (levels > 0 ? levels : 1))) == NULL) {
+			printf("SymbolicCount: Out of memory!\n");
+			exit(EXIT_FAILURE);
+		}
+		for (i = 0; i < pgs; i++)
+			row[i] = ((location **) st->locvec->coord)[i]->index;
+		memcpy(&row[pgs], st->valvec->coord, sizeof(int) * vars->n);
+		AppendToArray(rows, row);
+		DeleteCube(st->cube);
+		DeleteState(init->el[q]);
+	}
+	DeleteArray(init, NULL);
+	reach = frontier = MddFromRows(sm, lev, levels, (int **) rows->el, rows->n);
+	DeleteArray(rows, free);
+/*breadth-first search*/
+	while (frontier != MDD_FALSE) {
+		next = MDD_FALSE;
+		for (q = 0; q < groups->n; q++) {
+			g = groups->el[q];
+			Learn(&lr, g, sm, frontier);
+			memo = NewHashmap(INT);
+			next = MddOr(sm, next, Image(g, sm, frontier, g->relation, 0, memo));
+			DeleteHashmap(memo, DeleteVector);
+		}
+		frontier = MddMinus(sm, next, reach);
+		reach = MddOr(sm, reach, frontier);
+		iterations++;
+	}
+/*edges, final states and deadlocks*/
+	enabled = MDD_FALSE;
+	for (q = 0; q < groups->n; q++) {
+		g = groups->el[q];
+		memo = NewHashmap(INT);
+		next = Restrict(g, sm, reach, g->enabled, 0, memo);
+		DeleteHashmap(memo, DeleteVector);
+		edges += MddCount(sm, next);
+		enabled = MddOr(sm, enabled, next);
+	}
+	Learn(&lr, fin, sm, reach);
+	memo = NewHashmap(INT);
+	final = Restrict(fin, sm, reach, fin->enabled, 0, memo);
+	DeleteHashmap(memo, DeleteVector);
+	states = MddCount(sm, reach);
+	deadlocks = MddCount(sm, MddMinus(sm, MddMinus(sm, reach, enabled), final));
+	printf("\nSymbolic count (%i breadth-first iteration%s, %i nodes)\n\n", iterations, iterations == 1 ? "" : "s", sm->n);
+	if (states == 1)
+		printf("Degree 0: 1 element\n");
+	else
+		printf("Degree 0: %" PRIu64 " elements\n", states);
+	if (edges == 1)
+		printf("Degree 1: 1 element (2 boundaries)\n");
+	else if (edges > 1)
+		printf("Degree 1: %" PRIu64 " elements (%" PRIu64 " boundaries)\n", edges, 2 * edges);
+	if (deadlocks == 1)
+		printf("\n1 deadlock\n\n");
+	else
+		printf("\n%" PRIu64 " deadlocks\n\n", deadlocks);
+/*clear memory*/
+	DeleteArray(groups, DeleteGroup);
+	DeleteGroup(fin);
+	DeleteMdd(sm);
+	DeleteVector(lr.in);
+	DeleteVector(lr.out);
+	DeleteArray(lr.rows, NULL);
+	DeleteArray(lr.enabled, NULL);
+}
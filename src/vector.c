@@ -24,13 +24,163 @@
 pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
 File vector.c
 
-This file implements the functions declared in vector.h.
+This file implements the functions declared in vector.h. The comparison and hashing of INT 
+vectors use SSE2 or AVX2 kernels on x86 processors supporting them. The kernels are selected by 
+InitVectorKernels() and called through function pointers, the scalar kernels are used until then. 
+All kernels compute the same hash values.
 ************************************************************************************************/
 
 #include "vector.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include "def.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define VECTOR_SIMD	/*x86 kernels available*/
+#endif
+
+
+#define HASH_LANES 8	/*number of 32-bit lanes hashed in parallel*/
+#define HASH_LANEMUL 0x9e3779b1u	/*odd multiplier of the lanes*/
+#define HASH_FOLDMUL 0x9e3779b97f4a7c15u	/*odd multiplier for folding the lanes and the remaining coordinates*/
+
+
+/*Function prototypes*/
+
+static int EqualScalar(const int *x, const int *y, unsigned int n); /*Returns 1 iff the arrays of length n are equal*/
+static void LanesScalar(const int *x, unsigned int blocks, uint32_t acc[]); /*Hashes the blocks of HASH_LANES coordinates into the lanes acc*/
+static unsigned int FoldLanes(const int *x, unsigned int n, const uint32_t acc[]); /*Folds the lanes and the coordinates of x not in a block into the hash value of the array x of length n*/
+#ifdef VECTOR_SIMD
+static __m128i Mullo32SSE2(__m128i a, __m128i b); /*32-bit lane products a*b modulo 2^32*/
+static int EqualSSE2(const int *x, const int *y, unsigned int n); /*SSE2 version of EqualScalar*/
+static void LanesSSE2(const int *x, unsigned int blocks, uint32_t acc[]); /*SSE2 version of LanesScalar*/
+static int EqualAVX2(const int *x, const int *y, unsigned int n); /*AVX2 version of EqualScalar*/
+static void LanesAVX2(const int *x, unsigned int blocks, uint32_t acc[]); /*AVX2 version of LanesScalar*/
+#endif
+
+
+/*Selected kernels*/
+
+static int (*Equal)(const int *x, const int *y, unsigned int n) = EqualScalar;
+static void (*Lanes)(const int *x, unsigned int blocks, uint32_t acc[]) = LanesScalar;
+
+
+/*Function implementations*/
+
+/*Returns 1 iff the arrays of length n are equal*/
+
+static int EqualScalar(const int *x, const int *y, unsigned int n) {
+
+	unsigned int i;
+
+	for (i = 0; i < n; i++) 
+		if (x[i] != y[i])
+			return 0;
+	return 1;
+}
+
+
+/*Hashes the blocks of HASH_LANES coordinates into the lanes acc*/
+
+static void LanesScalar(const int *x, unsigned int blocks, uint32_t acc[]) {
+
+	unsigned int b, j;
+
+	for (b = 0; b < blocks; b++, x += HASH_LANES) 
+		for (j = 0; j < HASH_LANES; j++)
+			acc[j] = (acc[j] ^ (uint32_t) x[j]) * HASH_LANEMUL;
+}
+
+
+/*Folds the lanes and the coordinates of x not in a block into the hash value of the array x of length n*/
+
+static unsigned int FoldLanes(const int *x, unsigned int n, const uint32_t acc[]) {
+
+	uint64_t h = n;
+	unsigned int i;
+
+	for (i = 0; i < HASH_LANES; i++) 
+		h = (h ^ acc[i]) * HASH_FOLDMUL;
+	for (i = n - n % HASH_LANES; i < n; i++) 
+		h = (h ^ (uint32_t) x[i]) * HASH_FOLDMUL;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdu;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53u;
+	h ^= h >> 33;
+	return (unsigned int) h;
+}
+
+#ifdef VECTOR_SIMD
+
+/*32-bit lane products a*b modulo 2^32*/
+
+__attribute__((target("sse2"))) static __m128i Mullo32SSE2(__m128i a, __m128i b) {
+
+	const __m128i even = _mm_mul_epu32(a, b), odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+
+/*SSE2 version of EqualScalar*/
+
+__attribute__((target("sse2"))) static int EqualSSE2(const int *x, const int *y, unsigned int n) {
+
+	unsigned int i;
+
+	for (i = 0; i + 4 <= n; i += 4) 
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) &x[i]), _mm_loadu_si128((const __m128i *) &y[i]))) != 0xffff)
+			return 0;
+	return EqualScalar(&x[i], &y[i], n - i);
+}
+
+
+/*SSE2 version of LanesScalar*/
+
+__attribute__((target("sse2"))) static void LanesSSE2(const int *x, unsigned int blocks, uint32_t acc[]) {
+
+	const __m128i mul = _mm_set1_epi32((int) HASH_LANEMUL);
+	__m128i lo = _mm_loadu_si128((const __m128i *) acc), hi = _mm_loadu_si128((const __m128i *) &acc[4]);
+	unsigned int b;
+
+	for (b = 0; b < blocks; b++, x += HASH_LANES) {
+		lo = Mullo32SSE2(_mm_xor_si128(lo, _mm_loadu_si128((const __m128i *) x)), mul);
+		hi = Mullo32SSE2(_mm_xor_si128(hi, _mm_loadu_si128((const __m128i *) &x[4])), mul);
+	}
+	_mm_storeu_si128((__m128i *) acc, lo);
+	_mm_storeu_si128((__m128i *) &acc[4], hi);
+}
+
+
+/*AVX2 version of EqualScalar*/
+
+__attribute__((target("avx2"))) static int EqualAVX2(const int *x, const int *y, unsigned int n) {
+
+	unsigned int i;
+
+	for (i = 0; i + 8 <= n; i += 8) 
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) &x[i]), _mm256_loadu_si256((const __m256i *) &y[i]))) != -1)
+			return 0;
+	return EqualScalar(&x[i], &y[i], n - i);
+}
+
+
+/*AVX2 version of LanesScalar*/
+
+__attribute__((target("avx2"))) static void LanesAVX2(const int *x, unsigned int blocks, uint32_t acc[]) {
+
+	const __m256i mul = _mm256_set1_epi32((int) HASH_LANEMUL);
+	__m256i a = _mm256_loadu_si256((const __m256i *) acc);
+	unsigned int b;
+
+	for (b = 0; b < blocks; b++, x += HASH_LANES) 
+		a = _mm256_mullo_epi32(_mm256_xor_si256(a, _mm256_loadu_si256((const __m256i *) x)), mul);
+	_mm256_storeu_si256((__m256i *) acc, a);
+}
+
+#endif
 
 
 /*Creates new vector of given dimension and element size*/
@@ -84,12 +234,7 @@ int VecCmp(const vector *vec1, const vector *vec2, int type, int (*cmp)(const vo
 		diff = 0;	
 		switch (type) {
 			case INT: 
-				for (i = 0; i < vec1->dim; i++) {
-					if (((int *) vec1->coord)[i] != ((int *) vec2->coord)[i]) {
-						diff = 1;
-						break;
-					}
-				}
+				diff = !IntVecEqual(vec1, vec2);
 				break;			
 			default: 
 				if (cmp) {
@@ -122,3 +267,39 @@ int Veccmp(const void *vec1, const void *vec2) {
 	return VecCmp((vector *) vec1, (vector *) vec2, INT, NULL);
 
 }
+
+
+/*Selects the best kernels supported by the processor for IntVecEqual and IntVecHash, must be called before any threads are started*/
+
+void InitVectorKernels(void) {
+
+#ifdef VECTOR_SIMD
+	if (__builtin_cpu_supports("avx2")) {
+		Equal = EqualAVX2;
+		Lanes = LanesAVX2;
+	}
+	else if (__builtin_cpu_supports("sse2")) {
+		Equal = EqualSSE2;
+		Lanes = LanesSSE2;
+	}
+#endif
+}
+
+
+/*Returns 1 iff the INT vectors are equal*/
+
+int IntVecEqual(const vector *vec1, const vector *vec2) {
+
+	return vec1->dim == vec2->dim && Equal(vec1->coord, vec2->coord, vec1->dim);
+}
+
+
+/*Hash value of the INT vector*/
+
+unsigned int IntVecHash(const vector *vec) {
+
+	uint32_t acc[HASH_LANES] = {0};
+
+	Lanes(vec->coord, vec->dim / HASH_LANES, acc);
+	return FoldLanes(vec->coord, vec->dim, acc);
+}
@@ -0,0 +1,209 @@
+/*
+	Copyright (c) 2018-2025 Thomas Kahl
+
+	Permission is hereby granted, free of charge, to any person obtaining a copy
+	of this software and associated documentation files (the "Software"), to deal
+	in the Software without restriction, including without limitation the rights
+	to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+	copies of the Software, and to permit persons to whom the Software is
+	furnished to do so, subject to the following conditions:
+
+	The above copyright notice and this permission notice shall be included in all
+	copies or substantial portions of the Software.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+	IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+	FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+	AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+	LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+	OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+	SOFTWARE.
+*/
+
+/***********************************************************************************************
+pg2hda - Compute higher-dimensional automata modeling concurrent systems given by program graphs
+File verify.c
+
+This file implements the function declared in verify.h. For every cube, it checks 
+
+- the boundary identities d[k][i] d[l][j-1] = d[l][j] d[k][i] (i < j), 
+- that the cube belongs to the coface set s[k][i] of its face d[k][i], and that every element c 
+  of its coface sets s[k][i] is a cube of the next degree with c->d[k][i] equal to the cube, the 
+  elements of a coface set being ordered by increasing numbers,
+- that its edges start at its origin and are ordered by increasing pids, and that opposite 
+  faces d[0][i] and d[1][i] carry the same labels. 
+
+The origins of the cubes are taken from a corner table (see corners.h), which is built once if 
+the cubes are correctly numbered.
+
+The cubes of each degree are distributed among the threads in chunks. The HDA is not modified.
+************************************************************************************************/
+
+#include "verify.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "def.h"
+#include "vector.h"
+#include "array.h"
+#include "cube.h"
+#include "cubeset.h"
+#include "corners.h"
+
+
+#define CHUNK 256	/*number of cubes taken by a thread at a time*/
+
+
+/*Work on one degree*/
+
+typedef struct verifywork verifywork;
+
+struct verifywork {
+	int degree;
+	cube **cubes;	/*cubes of the degree*/
+	const cornertable *ct;	/*vertices of the cubes, NULL if the cubes are not correctly numbered*/
+	int n;	/*number of cubes*/
+	atomic_int next;	/*position of the next cubes to be checked*/
+	atomic_int errors[3];	/*numbers of cubes violating the boundary identities, with inconsistent coface sets and with inconsistent labels*/
+};
+
+
+/*Function prototypes*/
+
+static int CofacesOK(const cube *pc); /*Returns 1 if pc belongs to the coface sets of its faces and its own coface sets are consistent and 0 otherwise*/
+static int LabelsOK(const cube *pc, const cornertable *ct); /*Returns 1 if the edges of pc start at its origin (taken from ct unless it is NULL) with increasing pids and opposite faces have the same labels and 0 otherwise*/
+static void *VerifyWorker(void *arg); /*Checks the cubes of one degree in chunks*/
+
+
+/*Function implementations*/
+
+/*Returns 1 if pc belongs to the coface sets of its faces and its own coface sets are consistent and 0 otherwise*/
+
+static int CofacesOK(const cube *pc) {
+
+	int k, i;
+	unsigned int j;
+	const cubeset *cs;
+	const cube *c;
+
+	for (k = 0; k < 2; k++) {
+		for (i = 0; i < pc->degree; i++) 
+			if (!pc->d[k][i] || pc->d[k][i]->degree + 1 != pc->degree || !IsInCubeset(pc, &pc->d[k][i]->s[k][i])) 
+				return 0;
+		for (i = 0; i <= pc->degree; i++) {
+			cs = &pc->s[k][i];
+			for (j = 0; j < cs->n; j++) {
+				c = CubesetCubes(cs)[j];
+				if (c->degree != pc->degree + 1 || c->d[k][i] != pc || c->id != CubesetIds(cs)[j] || (j > 0 && CubesetIds(cs)[j - 1] >= c->id)) 
+					return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+
+/*Returns 1 if the edges of pc start at its origin (taken from ct unless it is NULL) with increasing pids and opposite faces have the same labels and 0 otherwise*/
+
+static int LabelsOK(const cube *pc, const cornertable *ct) {
+
+	int i, j;
+	const cube *origin = pc, *const *edge = pc->edges->coord, *const *e0, *const *e1;
+
+	if (pc->degree == 0) 
+		return pc->lab && pc->lab->dim > 0;
+	if (ct)
+		origin = CubeVertices(ct, pc)[0];
+	else
+		while (origin->degree > 0) 
+			origin = origin->d[0][0];
+	for (i = 0; i < pc->degree; i++) {
+		if (!edge[i] || edge[i]->degree != 1 || edge[i]->d[0][0] != origin || !edge[i]->lab || edge[i]->lab->dim == 0) 
+			return 0;
+		if (i > 0 && ((label **) edge[i - 1]->lab->coord)[0]->num >= ((label **) edge[i]->lab->coord)[0]->num) 
+			return 0;
+	}
+	if (pc->degree == 1) 
+		return edge[0] == pc;
+	for (i = 0; i < pc->degree; i++) {
+		e0 = pc->d[0][i]->edges->coord;
+		e1 = pc->d[1][i]->edges->coord;
+		for (j = 0; j < pc->degree - 1; j++) 
+			if (VecCmp(e0[j]->lab, e1[j]->lab, PTR, Labcmp) != 0) 
+				return 0;
+	}
+	return 1;
+}
+
+
+/*Checks the cubes of one degree in chunks*/
+
+static void *VerifyWorker(void *arg) {
+
+	verifywork *w = arg;
+	int pos, end, i;
+	const cube *pc;
+
+	while ((pos = atomic_fetch_add(&w->next, CHUNK)) < w->n) {
+		end = pos + CHUNK < w->n ? pos + CHUNK : w->n;
+		for (i = pos; i < end; i++) {
+			pc = w->cubes[i];
+			if (w->degree > 1 && !BdIdsOK(pc)) 
+				atomic_fetch_add(&w->errors[0], 1);
+			if (!CofacesOK(pc)) 
+				atomic_fetch_add(&w->errors[1], 1);
+			if (!LabelsOK(pc, w->ct)) 
+				atomic_fetch_add(&w->errors[2], 1);
+		}
+	}
+	return NULL;
+}
+
+
+/*Checks the boundary identities, the coface sets and the labels of all cubes of HDA cubes of dimension dim using the given number of threads, reports the result on stderr and returns the number of inconsistent cubes*/
+
+int VerifyHDA(array *const cubes[], int dim, int threads) {
+
+	int d, i, s, total = 0, errors[3] = {0, 0, 0};
+	verifywork w;
+	pthread_t *tid;
+	cornertable *ct;
+
+	threads = threads > 1 ? threads : 1;
+	if ((tid = malloc(sizeof(pthread_t) * threads)) == NULL) {
+		printf("VerifyHDA: Out of memory!\n");
+		exit(EXIT_FAILURE);
+	}
+/*cubes are numbered in the order of the array*/
+	for (d = 0; d <= dim; d++) 
+		for (i = 0; i < (int) cubes[d]->n; i++) 
+			if (((cube *) cubes[d]->el[i])->id != i) 	
+				errors[1]++;
+	ct = errors[1] == 0 ? NewCornertable(cubes, dim) : NULL;
+	w.ct = ct;
+	for (d = 0; d <= dim; d++) {
+		w.degree = d;
+		w.n = cubes[d]->n;
+		w.cubes = (cube **) cubes[d]->el;
+		atomic_init(&w.next, 0);
+		for (i = 0; i < 3; i++) 
+			atomic_init(&w.errors[i], 0);
+		for (s = 1; s < threads; s++) {
+			if (pthread_create(&tid[s], NULL, VerifyWorker, &w) != 0) {
+				printf("VerifyHDA: Thread creation failed!\n");
+				exit(EXIT_FAILURE);
+			}
+		}
+		VerifyWorker(&w);
+		for (s = 1; s < threads; s++) 
+			pthread_join(tid[s], NULL);
+		for (i = 0; i < 3; i++) 
+			errors[i] += atomic_load(&w.errors[i]);
+		total += w.n;
+	}
+	free(tid);
+	DeleteCornertable(ct);
+	fprintf(stderr, "HDA verification: %i cubes checked, %i violating the boundary identities, %i with inconsistent cofaces, %i with inconsistent labels\n", total, errors[0], errors[1], errors[2]);
+	return errors[0] + errors[1] + errors[2];
+}